@@ -0,0 +1,47 @@
+#include "alloc_counter.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<long long> allocations(0);
+
+long long heapAllocations() { return allocations.load(std::memory_order_relaxed); }
+
+static void* allocate(size_t size, size_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (!size) size = 1;
+    if (alignment <= alignof(std::max_align_t)) return malloc(size);
+    void* p = nullptr;
+    return posix_memalign(&p, alignment, size) == 0 ? p : nullptr;
+}
+
+// Every replaceable form of operator new is counted; all of them hand out
+// memory that free() releases.
+void* operator new(size_t size) {
+    if (void* p = allocate(size, 0)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(size_t size, std::align_val_t al) {
+    if (void* p = allocate(size, (size_t)al)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+void* operator new(size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return allocate(size, (size_t)al); }
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new[](size_t size, std::align_val_t al) { return operator new(size, al); }
+void* operator new[](size_t size, const std::nothrow_t& nt) noexcept { return operator new(size, nt); }
+void* operator new[](size_t size, std::align_val_t al, const std::nothrow_t& nt) noexcept { return operator new(size, al, nt); }
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { free(p); }
@@ -0,0 +1,6 @@
+#pragma once
+
+// Number of global operator new calls made by this process so far, in any
+// form. Only binaries that link alloc_counter.cpp count them. Used to
+// check that the game loop stays allocation-free after resetGame().
+long long heapAllocations();
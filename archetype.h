@@ -0,0 +1,161 @@
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
+// Entities of one kind stored as dense component columns, one vector per
+// component, so each system streams only the components it touches. Derived
+// lists its columns in a static columns(self, f). Capacity is fixed by
+// reserve() and add() never grows it. kill() only marks a row; flush() drops
+// the marked rows in one stable pass, so rows stay in spawn order and
+// indices stay valid until then.
+template <typename Derived>
+class Archetype {
+public:
+    void reserve(size_t capacity) {
+        cap = capacity;
+        Derived::columns(self(), [&](auto& c) { c.reserve(capacity); });
+        dead.reserve(capacity);
+        runs.reserve(capacity / 2 + 1);
+    }
+    size_t capacity() const { return cap; }
+    size_t size() const { return dead.size(); }
+    bool empty() const { return dead.empty(); }
+    bool full() const { return dead.size() >= cap; }
+    void clear() {
+        Derived::columns(self(), [](auto& c) { c.clear(); });
+        dead.clear();
+        killed = 0;
+    }
+
+    // Appends a row of default components for the caller to fill in; -1 when full.
+    int add() {
+        if (full()) return -1;
+        Derived::columns(self(), [](auto& c) { c.emplace_back(); });
+        dead.push_back(0);
+        return (int)dead.size() - 1;
+    }
+
+    // Replaces every row with rows default components, for a loader to fill
+    // in column by column; false past capacity.
+    bool assign(size_t rows) {
+        if (rows > cap) return false;
+        Derived::columns(self(), [&](auto& c) { c.assign(rows, {}); });
+        dead.assign(rows, 0);
+        killed = 0;
+        return true;
+    }
+
+    void kill(size_t row) {
+        if (dead[row]) return;
+        dead[row] = 1;
+        killed++;
+    }
+    bool alive(size_t row) const { return !dead[row]; }
+
+    void flush() {
+        if (!killed) return;
+        // The runs of survivors after the first dead row are found once; each
+        // column then slides them down, a block move per run.
+        size_t n = dead.size(), first = 0;
+        while (!dead[first]) first++;
+        runs.clear();
+        for (size_t r = first; r < n;) {
+            while (r < n && dead[r]) r++;
+            size_t begin = r;
+            while (r < n && !dead[r]) r++;
+            if (r > begin) runs.push_back({ (uint32_t)begin, (uint32_t)r });
+        }
+        Derived::columns(self(), [&](auto& c) {
+            auto to = c.begin() + first;
+            for (const Run& run : runs) to = std::move(c.begin() + run.begin, c.begin() + run.end, to);
+            c.erase(to, c.end());
+        });
+        dead.assign(n - killed, 0);
+        killed = 0;
+    }
+
+protected:
+    Derived& self() { return static_cast<Derived&>(*this); }
+    // Moves row from, dead mark and all, over row to.
+    void moveRow(size_t from, size_t to) {
+        Derived::columns(self(), [&](auto& c) { c[to] = std::move(c[from]); });
+        dead[to] = dead[from];
+    }
+    void resetRow(size_t row) {
+        Derived::columns(self(), [&](auto& c) { c[row] = {}; });
+        dead[row] = 0;
+    }
+
+    std::vector<uint8_t> dead;
+    size_t killed = 0;
+
+private:
+    struct Run { uint32_t begin, end; };
+    std::vector<Run> runs;
+    size_t cap = 0;
+};
+
+// An archetype whose rows are kept in Groups contiguous runs, group 0 first,
+// so a system can run one specialised loop per group. add(g) makes room at
+// the end of group g by moving the first row of each later group to that
+// group's end, so it costs a row move per later group but rows within a
+// group are not in spawn order. Derived::group(row) names a row's group.
+template <typename Derived, int Groups>
+class GroupedArchetype : public Archetype<Derived> {
+    using Base = Archetype<Derived>;
+
+public:
+    size_t begin(int g) const { return start[g]; }
+    size_t end(int g) const { return start[g + 1]; }
+
+    void clear() {
+        Base::clear();
+        std::fill(start, start + Groups + 1, 0);
+    }
+
+    // The new row has default components; the caller fills them in, group included.
+    int add(int g) {
+        int row = Base::add();
+        if (row < 0) return -1;
+        size_t hole = (size_t)row;
+        for (int h = Groups - 1; h > g; h--) {
+            if (start[h] < hole) this->moveRow(start[h], hole);
+            hole = start[h]++;
+        }
+        start[Groups] = this->size();
+        this->resetRow(hole);
+        return (int)hole;
+    }
+
+    void flush() {
+        if (!this->killed) return;
+        size_t removed = 0, from = 0;
+        for (int g = 1; g <= Groups; g++) {
+            size_t to = start[g];
+            for (size_t r = from; r < to; r++) removed += this->dead[r];
+            start[g] = to - removed;
+            from = to;
+        }
+        Base::flush();
+    }
+
+    // Finds the groups again after rows were filled in through assign();
+    // false if the rows are not grouped.
+    bool regroup() {
+        const Derived& d = static_cast<const Derived&>(*this);
+        size_t n = this->size();
+        int g = 0;
+        start[0] = 0;
+        for (size_t r = 0; r < n; r++) {
+            int rg = d.group(r);
+            if (rg < g || rg >= Groups) return false;
+            while (g < rg) start[++g] = r;
+        }
+        while (g < Groups) start[++g] = n;
+        return true;
+    }
+
+private:
+    size_t start[Groups + 1] = {};
+};
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "game.h"
+#include "bot.h"
+#include "work_pool.h"
+
+// Monte-Carlo batch runner: plays many independent games on all cores, one
+// seed each, with a scripted bot, and reports how far they got. Each game
+// ends at its first game over or at the time cap. Prints a JSON summary on
+// stdout; --csv writes one row per game. results_hash folds every game's
+// final world hash in seed order, so it must not depend on --threads.
+
+struct GameResult {
+    uint64_t seed, hash;
+    int score, wave;
+    float survival;
+    long ticks, playingTicks, starvedTicks;
+    bool gameOver;
+    double tickNs;
+    float worstTickUs;
+};
+
+static GameResult playGame(uint64_t seed, const BotConfig& bot, float dt, long maxTicks) {
+    using clock = std::chrono::steady_clock;
+    World w;
+    seedWorld(w, seed);
+    GameResult r = {};
+    r.seed = seed;
+    double totalNs = 0;
+    long t = 0;
+    for (; t < maxTicks; t++) {
+        Input in = botInput(w, t, bot);
+        GameState before = w.gameState;
+        auto start = clock::now();
+        step(w, in, dt);
+        double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        totalNs += ns;
+        r.worstTickUs = std::max(r.worstTickUs, (float)(ns / 1e3));
+        if (w.gameState == PLAYING) {
+            r.playingTicks++;
+            if (w.ammo == 0) r.starvedTicks++;
+        }
+        if (before != GAME_OVER && w.gameState == GAME_OVER) { r.gameOver = true; t++; break; }
+    }
+    r.ticks = t;
+    r.tickNs = totalNs / std::max(1L, t);
+    r.score = w.score;
+    r.wave = w.wave;
+    r.survival = w.survivalTime;
+    r.hash = hashWorld(w);
+    return r;
+}
+
+template <typename T, typename Key>
+static float percentile(const std::vector<T>& v, Key key, float q) {
+    std::vector<float> xs;
+    for (const T& x : v) xs.push_back(key(x));
+    std::sort(xs.begin(), xs.end());
+    return xs[std::min(xs.size() - 1, (size_t)(q * xs.size()))];
+}
+
+int main(int argc, char** argv) {
+    long games = 1000;
+    int threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    uint64_t seed = 1;
+    float maxSeconds = 600;
+    int tickRate = 60;
+    const char* csvPath = nullptr;
+    const char* preset = "default";
+    BotConfig bot;
+    float flee = -1, kite = -1, dash = -1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--games") && i + 1 < argc) games = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--max-seconds") && i + 1 < argc) maxSeconds = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--tick-rate") && i + 1 < argc) tickRate = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--csv") && i + 1 < argc) csvPath = argv[++i];
+        else if (!strcmp(argv[i], "--bot") && i + 1 < argc) preset = argv[++i];
+        else if (!strcmp(argv[i], "--flee") && i + 1 < argc) flee = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--kite") && i + 1 < argc) kite = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--dash") && i + 1 < argc) dash = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--horde")) bot.horde = true;
+        else {
+            fprintf(stderr, "usage: %s [--games N] [--threads N] [--seed FIRST] [--max-seconds S] [--tick-rate HZ] [--horde]\n"
+                            "       [--bot default|kite|aggressive] [--flee PX] [--kite PX] [--dash PX] [--csv FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (!botPreset(preset, bot)) { fprintf(stderr, "unknown bot %s\n", preset); return 1; }
+    if (flee >= 0) bot.fleeRange = flee;
+    if (kite >= 0) bot.kiteRange = kite;
+    if (dash >= 0) bot.dashRange = dash;
+    if (games <= 0 || tickRate <= 0) { fprintf(stderr, "--games and --tick-rate must be positive\n"); return 1; }
+    float dt = 1.0f / tickRate;
+    long maxTicks = (long)(maxSeconds * tickRate);
+
+    std::vector<GameResult> results(games);
+    WorkPool pool(threads);
+    auto t0 = std::chrono::steady_clock::now();
+    pool.run(games, [&](size_t g, int) { results[g] = playGame(seed + g, bot, dt, maxTicks); });
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    if (csvPath) {
+        FILE* f = fopen(csvPath, "w");
+        if (!f) { fprintf(stderr, "cannot write %s\n", csvPath); return 1; }
+        fprintf(f, "seed,game_over,score,wave,survival_s,ticks,ammo_starved_fraction,tick_ns_mean,tick_us_worst\n");
+        for (const GameResult& r : results)
+            fprintf(f, "%llu,%d,%d,%d,%.2f,%ld,%.4f,%.0f,%.1f\n", (unsigned long long)r.seed, r.gameOver, r.score, r.wave,
+                    r.survival, r.ticks, r.playingTicks ? (double)r.starvedTicks / r.playingTicks : 0.0, r.tickNs, r.worstTickUs);
+        fclose(f);
+    }
+
+    long totalTicks = 0, over = 0, starvedGames = 0;
+    double tickNs = 0, starved = 0;
+    float worstUs = 0;
+    int maxWave = 0;
+    uint64_t hash = 14695981039346656037ULL;
+    for (const GameResult& r : results) {
+        totalTicks += r.ticks;
+        tickNs += r.tickNs * r.ticks;
+        over += r.gameOver;
+        starved += r.playingTicks ? (double)r.starvedTicks / r.playingTicks : 0;
+        starvedGames += r.starvedTicks > 0;
+        worstUs = std::max(worstUs, r.worstTickUs);
+        maxWave = std::max(maxWave, r.wave);
+        hash = (hash ^ r.hash) * 1099511628211ULL;
+    }
+    std::vector<long> waves(maxWave + 1, 0);
+    for (const GameResult& r : results) waves[r.wave]++;
+    auto survival = [](const GameResult& r) { return r.survival; };
+    auto wave = [](const GameResult& r) { return (float)r.wave; };
+
+    printf("{\n  \"games\": %ld,\n  \"threads\": %d,\n  \"steals\": %ld,\n  \"bot\": \"%s\",\n  \"mode\": \"%s\",\n", games,
+           pool.threads(), pool.steals, preset, bot.horde ? "horde" : "classic");
+    printf("  \"wall_s\": %.3f,\n  \"games_per_s\": %.1f,\n  \"ticks\": %ld,\n  \"ticks_per_s\": %.0f,\n", wall, games / wall,
+           totalTicks, totalTicks / wall);
+    printf("  \"game_over\": %ld,\n  \"capped\": %ld,\n", over, games - over);
+    printf("  \"survival_s\": {\"p10\": %.1f, \"p50\": %.1f, \"p90\": %.1f},\n", percentile(results, survival, 0.1f),
+           percentile(results, survival, 0.5f), percentile(results, survival, 0.9f));
+    printf("  \"wave\": {\"p10\": %.0f, \"p50\": %.0f, \"p90\": %.0f, \"max\": %d},\n", percentile(results, wave, 0.1f),
+           percentile(results, wave, 0.5f), percentile(results, wave, 0.9f), maxWave);
+    printf("  \"games_reaching_wave\": [");
+    long reached = games;
+    for (int v = 1; v <= maxWave; v++) {
+        printf("%s%ld", v > 1 ? ", " : "", reached);
+        reached -= waves[v];
+    }
+    printf("],\n  \"ammo_starved_fraction\": %.4f,\n  \"games_starved\": %ld,\n", starved / games, starvedGames);
+    printf("  \"tick_ns_mean\": %.0f,\n  \"tick_us_worst\": %.1f,\n", tickNs / std::max(1L, totalTicks), worstUs);
+    printf("  \"results_hash\": \"%016llx\"\n}\n", (unsigned long long)hash);
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <cmath>
+#include "game.h"
+#include "render_frame.h"
+#include "renderer.h"
+
+// Synthetic scenes for timing step() phase by phase and drawScene() on the
+// CPU. Every repetition restarts from a copy of the scene so the work per
+// tick stays comparable between runs. Prints JSON on stdout.
+
+struct Scenario {
+    const char* name;
+    int enemies, bullets, particles;
+    bool nuke;
+};
+
+static const Scenario scenarios[] = {
+    { "idle", 0, 0, 0, false },
+    { "enemies_100", 100, 0, 0, false },
+    { "enemies_1k", 1000, 0, 0, false },
+    { "enemies_10k", 10000, 0, 0, false },
+    { "bullets_1k", 0, 1000, 0, false },
+    { "bullets_50k", 0, 50000, 0, false },
+    { "particles_1k", 0, 0, 1000, false },
+    { "particles_50k", 0, 0, 50000, false },
+    { "combat_1k", 1000, 1000, 10000, false },
+    { "combat_10k", 10000, 5000, 50000, false },
+    { "nuke_burst", 4000, 0, 0, true },
+};
+
+static float frand(Rng& r, float lo, float hi) { return lo + (hi - lo) * (r.next() >> 8) * (1.0f / (1 << 24)); }
+
+static void buildScene(World& w, const Scenario& s) {
+    w.config.maxEnemies = std::max(w.config.maxEnemies, s.enemies);
+    w.config.maxBullets = std::max(w.config.maxBullets, s.bullets);
+    w.config.maxParticles = std::max(w.config.maxParticles, s.particles);
+    seedWorld(w, 1);
+    resetGame(w);
+    // No spawning, no wave end, no game over: the scene stays as built.
+    w.enemiesLeftInWave = 1;
+    w.spawnTimer = -1e9f;
+    w.ammoSpawnTimer = w.powerUpSpawnTimer = -1e9f;
+    w.playerHealth = 1 << 30;
+
+    Rng r;
+    r.seed(42, 7);
+    for (int i = 0; i < s.enemies; i++) {
+        // A ring well away from the player so contacts are rare within a repetition.
+        float a = frand(r, 0, 6.2832f), d = frand(r, 150, 400);
+        EnemyType type = (EnemyType)r.range(3);
+        int e = w.enemies.add(type);
+        w.enemies.pos[e] = { 400 + cosf(a) * d, 300 + sinf(a) * d * 0.7f };
+        w.enemies.radius[e] = ENEMY_TRAITS[type].radius;
+        w.enemies.health[e] = 1 + (int)type;
+        w.enemies.type[e] = type;
+        w.enemies.id[e] = ++w.nextId;
+    }
+    for (int i = 0; i < s.bullets; i++) {
+        float a = frand(r, 0, 6.2832f);
+        int b = w.bullets.add();
+        w.bullets.pos[b].x = frand(r, 0, ARENA_W);
+        w.bullets.pos[b].y = frand(r, 0, ARENA_H);
+        w.bullets.vel[b] = { cosf(a), sinf(a) };
+        w.bullets.id[b] = ++w.nextId;
+    }
+    for (int i = 0; i < s.particles; i++)
+        w.particles.emit({ frand(r, 0, ARENA_W), frand(r, 0, ARENA_H) }, { frand(r, -4, 4), frand(r, -4, 4) }, frand(r, 2, 6));
+    if (s.nuke) w.nukes = 1;
+}
+
+struct Result {
+    long ticks = 0;
+    double tickNs = 0, sceneNs = 0;
+    Profiler prof;
+};
+
+static Result run(const Scenario& s, int reps, int ticksPerRep) {
+    using clock = std::chrono::steady_clock;
+    World base;
+    buildScene(base, s);
+    Result res;
+    RenderFrame frame;
+    for (int rep = 0; rep < reps; rep++) {
+        World w = base;
+        w.profiler = &res.prof;
+        for (int t = 0; t < ticksPerRep; t++) {
+            Input in;
+            in.nuke = s.nuke && t == 0;
+            auto t0 = clock::now();
+            step(w, in, TICK);
+            res.tickNs += std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+            res.ticks++;
+
+            captureFrame(w, t, frame);
+            auto t1 = clock::now();
+            drawScene(frame);
+            res.sceneNs += std::chrono::duration<double, std::nano>(clock::now() - t1).count();
+            discardBatches();
+        }
+    }
+    return res;
+}
+
+// The per-enemy tail of steering and the colour pick of drawing, over the
+// same enemies written two ways: one loop over all of them that looks the
+// type up for each enemy, as before enemies were grouped, and one loop per
+// type group with the traits as constants.
+const int LOOP_ENEMIES = 10000;
+
+struct LoopResult { double mixedNs = 0, groupedNs = 0, check = 0; };
+
+static LoopResult enemyLoops(int reps) {
+    using clock = std::chrono::steady_clock;
+    // pos and vel of the grouped enemies stand in for the chase and push terms.
+    Enemies grouped;
+    grouped.reserve(LOOP_ENEMIES);
+    std::vector<EnemyType> mixedType;
+    std::vector<Vec2> mixedChase, mixedPush, vel(LOOP_ENEMIES);
+    Rng r;
+    r.seed(42, 8);
+    for (int i = 0; i < LOOP_ENEMIES; i++) {
+        EnemyType type = (EnemyType)r.range(ENEMY_TYPES);
+        Vec2 c = { frand(r, -1, 1), frand(r, -1, 1) }, p = { frand(r, -1, 1), frand(r, -1, 1) };
+        mixedType.push_back(type);
+        mixedChase.push_back(c);
+        mixedPush.push_back(p);
+        int e = grouped.add(type);
+        grouped.type[e] = type;
+        grouped.pos[e] = c;
+        grouped.vel[e] = p;
+    }
+
+    LoopResult res;
+    float slowMult = 1;
+    for (int rep = 0; rep < reps; rep++) {
+        auto t0 = clock::now();
+        for (int i = 0; i < LOOP_ENEMIES; i++) {
+            EnemyType type = mixedType[i];
+            const EnemyTraits& s = ENEMY_TRAITS[type];
+            Vec2 desired = mixedChase[i] * s.pursuit + mixedPush[i] * s.separation;
+            vel[i] = normalize(desired) * s.speed * slowMult;
+            float R = 1, G = 0, B = 0;
+            if (type == FAST) { R = 1; G = 0.5f; B = 0; }
+            else if (type == TANK) { R = 0.8f; G = 0; B = 0.8f; }
+            res.check += R + G + B + vel[i].x;
+        }
+        auto t1 = clock::now();
+        forEachEnemyType([&](auto type) {
+            constexpr EnemyTraits t = ENEMY_TRAITS[decltype(type)::value];
+            for (size_t i = grouped.begin(type), end = grouped.end(type); i < end; i++) {
+                Vec2 desired = grouped.pos[i] * t.pursuit + grouped.vel[i] * t.separation;
+                vel[i] = normalize(desired) * t.speed * slowMult;
+                res.check += t.r + t.g + t.b + vel[i].x;
+            }
+        });
+        auto t2 = clock::now();
+        res.mixedNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        res.groupedNs += std::chrono::duration<double, std::nano>(t2 - t1).count();
+    }
+    res.mixedNs /= (double)reps * LOOP_ENEMIES;
+    res.groupedNs /= (double)reps * LOOP_ENEMIES;
+    return res;
+}
+
+int main(int argc, char** argv) {
+    int reps = 5, ticksPerRep = 30;
+    const char* filter = nullptr;
+    int quality = QUALITY_LEVELS - 1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--reps") && i + 1 < argc) reps = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) ticksPerRep = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--filter") && i + 1 < argc) filter = argv[++i];
+        else if (!strcmp(argv[i], "--quality") && i + 1 < argc) quality = atoi(argv[++i]);
+        else { fprintf(stderr, "usage: %s [--reps N] [--ticks N] [--filter SUBSTRING] [--quality 0-%d]\n", argv[0], QUALITY_LEVELS - 1); return 1; }
+    }
+    setRenderQuality(qualityLevel(quality));
+
+    printf("{\n  \"reps\": %d,\n  \"ticks_per_rep\": %d,\n  \"quality\": %d,\n  \"benchmarks\": [", reps, ticksPerRep, quality);
+    bool first = true;
+    for (const Scenario& s : scenarios) {
+        if (filter && !strstr(s.name, filter)) continue;
+        Result r = run(s, reps, ticksPerRep);
+        printf("%s\n    {\"name\": \"%s\", \"enemies\": %d, \"bullets\": %d, \"particles\": %d, \"ticks\": %ld,\n",
+               first ? "" : ",", s.name, s.enemies, s.bullets, s.particles, r.ticks);
+        printf("     \"ns_per_tick\": %.0f, \"scene_ns_per_frame\": %.0f,\n", r.tickNs / r.ticks, r.sceneNs / r.ticks);
+        printf("     \"phase_ns_per_tick\": {");
+        for (int p = 0; p < SIM_PHASES_END; p++)
+            printf("%s\"%s\": %.0f", p ? ", " : "", phaseName(p), (double)r.prof.ns[p] / r.ticks);
+        printf("}}");
+        first = false;
+    }
+    printf("\n  ]");
+    if (!filter || strstr("enemy_loops", filter)) {
+        LoopResult l = enemyLoops(reps * ticksPerRep);
+        printf(",\n  \"enemy_loops\": {\"enemies\": %d, \"mixed_ns_per_enemy\": %.2f, \"grouped_ns_per_enemy\": %.2f, \"check\": %.0f}",
+               LOOP_ENEMIES, l.mixedNs, l.groupedNs, l.check);
+    }
+    printf("\n}\n");
+    return 0;
+}
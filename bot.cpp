@@ -0,0 +1,90 @@
+#include "bot.h"
+#include <cmath>
+#include <cstring>
+
+// Holds the direction keys that move the player towards d, ignoring
+// components smaller than dead.
+static void steer(Input& in, Vec2 d, float dead) {
+    in.left = d.x < -dead;
+    in.right = d.x > dead;
+    in.down = d.y < -dead;
+    in.up = d.y > dead;
+}
+
+// Index of the ammo box nearest the player, -1 if there is none.
+static int nearestBox(const World& w) {
+    int nearest = -1;
+    float best = 1e30f;
+    const std::vector<Vec2>& pos = w.ammoBoxes.pos;
+    for (size_t i = 0; i < pos.size(); i++)
+        if (dist2(pos[i], w.player.pos) < best) { best = dist2(pos[i], w.player.pos); nearest = (int)i; }
+    return nearest;
+}
+
+Input botInput(const World& w, long tick, const BotConfig& bot) {
+    Input in;
+    if (w.gameState == MENU) (bot.horde ? in.horde : in.start) = true;
+    if (w.gameState == GAME_OVER) in.restart = true;
+
+    const Vec2* nearest = nullptr;
+    float best = 1e30f;
+    const std::vector<Vec2>& enemies = w.enemies.pos;
+    for (size_t i = 0; i < enemies.size(); i++) {
+        Vec2 d = { enemies[i].x - w.player.pos.x, enemies[i].y - w.player.pos.y };
+        float d2 = d.x * d.x + d.y * d.y;
+        if (d2 < best) { best = d2; nearest = &enemies[i]; }
+    }
+    bool threatened = nearest && best < bot.fleeRange * bot.fleeRange;
+    int box = bot.seekAmmo && w.ammo < bot.lowAmmo ? nearestBox(w) : -1;
+    if (nearest) {
+        in.aimX = nearest->x;
+        in.aimY = nearest->y;
+        in.fire = true;
+        if (threatened) {
+            in.left = nearest->x > w.player.pos.x;
+            in.right = !in.left;
+            in.down = nearest->y > w.player.pos.y;
+            in.up = !in.down;
+            in.dash = best < bot.dashRange * bot.dashRange;
+        }
+        else if (box >= 0) steer(in, w.ammoBoxes.pos[box] - w.player.pos, 5);
+        else if (best < bot.kiteRange * bot.kiteRange) {
+            Vec2 d = *nearest - w.player.pos;
+            steer(in, { -d.y, d.x }, 0.3f * sqrtf(best));
+        }
+    }
+    else if (!w.ammoBoxes.empty()) {
+        in.left = w.ammoBoxes.pos[0].x < w.player.pos.x - 5;
+        in.right = w.ammoBoxes.pos[0].x > w.player.pos.x + 5;
+        in.down = w.ammoBoxes.pos[0].y < w.player.pos.y - 5;
+        in.up = w.ammoBoxes.pos[0].y > w.player.pos.y + 5;
+    }
+    in.nuke = w.enemies.size() > bot.nukeCrowd && tick % bot.nukeEvery == 0;
+    return in;
+}
+
+Input autopilot(const World& w, long tick, bool horde) {
+    BotConfig bot;
+    bot.horde = horde;
+    return botInput(w, tick, bot);
+}
+
+bool botPreset(const char* name, BotConfig& bot) {
+    bool horde = bot.horde;
+    bot = BotConfig();
+    bot.horde = horde;
+    if (!strcmp(name, "default")) return true;
+    if (!strcmp(name, "kite")) {
+        bot.fleeRange = 90;
+        bot.kiteRange = 260;
+        bot.seekAmmo = true;
+        return true;
+    }
+    if (!strcmp(name, "aggressive")) {
+        bot.fleeRange = 45;
+        bot.dashRange = 30;
+        bot.nukeCrowd = 30;
+        return true;
+    }
+    return false;
+}
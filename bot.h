@@ -0,0 +1,22 @@
+#pragma once
+#include "game.h"
+
+// Scripted player for headless runs: aims and fires at the nearest enemy,
+// backs away from it inside fleeRange and dashes inside dashRange. With
+// kiteRange set it strafes around the nearest enemy further out; with
+// seekAmmo it fetches ammo boxes once below lowAmmo instead of only when
+// the arena is clear.
+struct BotConfig {
+    bool horde = false;  // start horde games from the menu
+    float fleeRange = 120, dashRange = 50, kiteRange = 0;
+    bool seekAmmo = false;
+    int lowAmmo = 10;
+    size_t nukeCrowd = 12;  // nuke when more enemies than this are alive,
+    int nukeEvery = 60;     // checked every nukeEvery ticks
+};
+
+Input botInput(const World& w, long tick, const BotConfig& bot);
+// The default bot, which the headless runner and gs_offscreen use.
+Input autopilot(const World& w, long tick, bool horde);
+// Fills bot from a preset name ("default", "kite", "aggressive"); false if unknown.
+bool botPreset(const char* name, BotConfig& bot);
@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include "bot.h"
+#include "coop.h"
+#include "game.h"
+
+// Headless co-op client: joins a gs_server, flies its ship with a scripted
+// bot, predicts its own movement from its inputs and reconciles with every
+// snapshot. Reports what it received and how far the prediction was off.
+
+const int INPUT_RING = 64;
+// Unacknowledged inputs resent with each packet.
+const uint32_t MAX_RESEND = 16;
+
+int main(int argc, char** argv) {
+    const char* host = "127.0.0.1";
+    int port = COOP_PORT;
+    long ticks = 3600;
+    float loss = 0;
+    uint64_t seed = 1;
+    const char* preset = "default";
+    BotConfig bot;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--server") && i + 1 < argc) host = argv[++i];
+        else if (!strcmp(argv[i], "--port") && i + 1 < argc) port = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) ticks = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--bot") && i + 1 < argc) preset = argv[++i];
+        else if (!strcmp(argv[i], "--horde")) bot.horde = true;
+        else if (!strcmp(argv[i], "--loss") && i + 1 < argc) loss = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = strtoull(argv[++i], nullptr, 10);
+        else {
+            fprintf(stderr, "usage: %s [--server HOST] [--port N] [--ticks N] [--bot default|kite|aggressive] [--horde]\n"
+                            "       [--loss PERCENT] [--seed S]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (!botPreset(preset, bot)) { fprintf(stderr, "unknown bot %s\n", preset); return 1; }
+
+    NetAddress server;
+    UdpSocket sock;
+    if (!resolveAddress(host, port, server)) { fprintf(stderr, "cannot resolve %s\n", host); return 1; }
+    if (!sock.open(0)) { fprintf(stderr, "cannot open a UDP socket\n"); return 1; }
+
+    using clock = std::chrono::steady_clock;
+    static uint8_t buf[65536];
+    std::vector<uint8_t> packet;
+    int slot = -1, tickRate = 0;
+    NetAddress from;
+    for (int attempt = 0; attempt < 20 && slot < 0; attempt++) {
+        packet.clear();
+        ByteWriter out{ packet };
+        out.u8(PK_HELLO);
+        out.u32(COOP_PROTOCOL);
+        sock.send(server, packet.data(), packet.size());
+        auto until = clock::now() + std::chrono::milliseconds(250);
+        while (slot < 0 && clock::now() < until) {
+            long n = sock.receive(buf, sizeof buf, from);
+            if (n <= 0 || !(from == server)) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); continue; }
+            ByteReader in{ buf, (size_t)n };
+            uint8_t type = in.u8();
+            if (type == PK_FULL) { fprintf(stderr, "server is full\n"); return 1; }
+            if (type != PK_WELCOME) continue;
+            slot = in.u8();
+            tickRate = (int)in.varint();
+            in.varint();
+            if (!in.ok || tickRate <= 0) slot = -1;
+        }
+    }
+    if (slot < 0) { fprintf(stderr, "no answer from %s:%d\n", host, port); return 1; }
+    printf("joined as slot %d at %d Hz\n", slot, tickRate);
+    fflush(stdout);
+    float dt = 1.0f / tickRate;
+
+    // The client's picture of the game: the last snapshot's entities and
+    // team state, with its own ship predicted ahead of the server.
+    World view;
+    allocateWorld(view);
+    float dashCooldown = 0;
+    static NetView history[COOP_HISTORY];
+    long latest = 0;
+    uint32_t seq = 0, acked = 0;
+    uint32_t seqs[INPUT_RING] = {};
+    Input sent[INPUT_RING];
+    Vec2 predicted[INPUT_RING];
+    long sentAt[INPUT_RING] = {};
+    Rng lossRng;
+    lossRng.seed(seed, 3);
+
+    long received = 0, dropped = 0, unbased = 0, corrupt = 0, deltas = 0, checked = 0, exact = 0;
+    long long bytes = 0, entities = 0, rttTicks = 0;
+    long rttMax = 0;
+    double errSum = 0;
+    float errMax = 0;
+    bool serverGone = false;
+
+    auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(dt));
+    auto due = clock::now();
+    long tick = 0;
+    for (; tick < ticks && !serverGone; tick++) {
+        due += period;
+        std::this_thread::sleep_until(due);
+        if (clock::now() - due > period * 5) due = clock::now();
+
+        long n;
+        while ((n = sock.receive(buf, sizeof buf, from)) > 0) {
+            if (!(from == server)) continue;
+            ByteReader in{ buf, (size_t)n };
+            uint8_t type = in.u8();
+            if (type == PK_BYE) { serverGone = true; break; }
+            if (type != PK_SNAPSHOT) continue;
+            if (loss > 0 && lossRng.range(10000) < loss * 100) { dropped++; continue; }
+            NetHeader h;
+            if (!readSnapshotHeader(in, h)) { corrupt++; continue; }
+            if (h.tick <= latest) continue;
+            const NetView* base = nullptr;
+            if (h.baseline) {
+                base = &history[h.baseline % COOP_HISTORY];
+                if (base->tick != h.baseline) { unbased++; continue; }
+            }
+            NetView& v = history[h.tick % COOP_HISTORY];
+            if (!readSnapshotView(in, h.tick, base, v)) { v.tick = 0; corrupt++; continue; }
+            received++;
+            deltas += base != nullptr;
+            bytes += n;
+            entities += (long long)v.entities();
+            latest = h.tick;
+
+            applyView(v, view);
+            view.gameState = h.gameState; view.mode = h.mode; view.hasShield = h.hasShield;
+            view.score = h.score; view.ammo = h.ammo; view.nukes = h.nukes;
+            view.playerHealth = h.health; view.maxHealth = h.maxHealth;
+            view.wave = h.wave; view.enemiesLeftInWave = h.enemiesLeft; view.comboCount = h.combo;
+            view.survivalTime = h.survivalTime;
+            view.player.alive = h.alive;
+
+            // Reconcile: compare the prediction for the last input the
+            // server applied, take the server's ship and replay the inputs
+            // it has not seen yet.
+            if (h.inputSeq > acked) {
+                uint32_t r = h.inputSeq % INPUT_RING;
+                if (seqs[r] == h.inputSeq) {
+                    float err = length(predicted[r] - h.shipPos);
+                    checked++;
+                    exact += err < 1e-3f;
+                    errSum += err;
+                    errMax = std::max(errMax, err);
+                    rttTicks += tick - sentAt[r];
+                    rttMax = std::max(rttMax, tick - sentAt[r]);
+                }
+                acked = h.inputSeq;
+            }
+            view.player.pos = h.shipPos;
+            dashCooldown = h.dashCooldown;
+            for (uint32_t s = acked + 1; s <= seq; s++) {
+                uint32_t r = s % INPUT_RING;
+                if (view.gameState == PLAYING && view.player.alive) predictShip(view.player, dashCooldown, sent[r], dt);
+                predicted[r] = view.player.pos;
+            }
+        }
+
+        Input in = quantizeInput(botInput(view, tick, bot));
+        seq++;
+        uint32_t r = seq % INPUT_RING;
+        seqs[r] = seq;
+        sent[r] = in;
+        sentAt[r] = tick;
+        if (view.gameState == PLAYING && view.player.alive) predictShip(view.player, dashCooldown, in, dt);
+        predicted[r] = view.player.pos;
+
+        uint32_t first = std::max(acked + 1, seq + 1 - std::min(seq, MAX_RESEND));
+        packet.clear();
+        ByteWriter out{ packet };
+        out.u8(PK_INPUT);
+        out.varint((uint64_t)latest);
+        out.varint(first);
+        out.u8((uint8_t)(seq - first + 1));
+        for (uint32_t s = first; s <= seq; s++) writeNetInput(out, sent[s % INPUT_RING]);
+        sock.send(server, packet.data(), packet.size());
+    }
+    if (!serverGone) {
+        uint8_t bye = PK_BYE;
+        sock.send(server, &bye, 1);
+    }
+
+    double secs = tick * dt;
+    printf("slot %d  ticks %ld  final score %d  wave %d\n", slot, tick, view.score, view.wave);
+    printf("snapshots %ld  delta-coded %.1f%%  dropped (simulated) %ld  missing baseline %ld  corrupt %ld\n", received,
+           received ? 100.0 * deltas / received : 0.0, dropped, unbased, corrupt);
+    printf("bytes/snapshot %.0f  kbit/s %.1f  entities/snapshot %.0f\n", received ? (double)bytes / received : 0.0,
+           secs > 0 ? bytes * 8 / secs / 1000 : 0.0, received ? (double)entities / received : 0.0);
+    printf("prediction checked %ld  exact %.1f%%  mean error %.3f px  max %.2f px  input round trip %.1f ticks (max %ld)\n",
+           checked, checked ? 100.0 * exact / checked : 0.0, checked ? errSum / checked : 0.0, errMax,
+           checked ? (double)rttTicks / checked : 0.0, rttMax);
+    return 0;
+}
@@ -0,0 +1,273 @@
+#include "coop.h"
+#include <algorithm>
+#include <cmath>
+
+static int16_t fixed(float v, float scale) {
+    return (int16_t)std::max(-32768.0f, std::min(32767.0f, roundf(v * scale)));
+}
+
+void writeNetInput(ByteWriter& out, const Input& in) {
+    out.u8((uint8_t)(in.up | in.down << 1 | in.left << 2 | in.right << 3 | in.fire << 4));
+    out.u8((uint8_t)(in.start | in.restart << 1 | in.menu << 2 | in.pause << 3 | in.dash << 4 | in.nuke << 5 | in.horde << 6));
+    out.i16(fixed(in.aimX, 16));
+    out.i16(fixed(in.aimY, 16));
+}
+
+Input readNetInput(ByteReader& in) {
+    Input r;
+    uint8_t held = in.u8(), actions = in.u8();
+    r.up = held & 1; r.down = held & 2; r.left = held & 4; r.right = held & 8; r.fire = held & 16;
+    r.start = actions & 1; r.restart = actions & 2; r.menu = actions & 4; r.pause = actions & 8;
+    r.dash = actions & 16; r.nuke = actions & 32; r.horde = actions & 64;
+    r.aimX = in.i16() / 16.0f;
+    r.aimY = in.i16() / 16.0f;
+    return r;
+}
+
+Input quantizeInput(const Input& in) {
+    Input r = in;
+    r.aimX = fixed(in.aimX, 16) / 16.0f;
+    r.aimY = fixed(in.aimY, 16) / 16.0f;
+    return r;
+}
+
+void fillHeader(const World& w, int slot, NetHeader& h) {
+    h.gameState = w.gameState;
+    h.mode = w.mode;
+    h.hasShield = w.hasShield;
+    h.score = w.score; h.ammo = w.ammo; h.nukes = w.nukes; h.health = w.playerHealth; h.maxHealth = w.maxHealth;
+    h.wave = w.wave; h.enemiesLeft = w.enemiesLeftInWave; h.combo = w.comboCount;
+    h.survivalTime = w.survivalTime;
+    h.slot = slot;
+    const Ship& own = slot == 0 ? w.player : w.allies[slot - 1].ship;
+    h.shipPos = own.pos;
+    h.dashCooldown = slot == 0 ? w.dashCooldown : w.allies[slot - 1].dashCooldown;
+    h.alive = own.alive;
+    h.ships = 1;
+    h.shipPositions[0] = w.player.pos;
+    for (int i = 0; i < MAX_PLAYERS - 1; i++)
+        if (w.allies[i].joined) {
+            h.ships |= (uint8_t)(1 << (i + 1));
+            h.shipPositions[i + 1] = w.allies[i].ship.pos;
+        }
+}
+
+static void writeHeader(ByteWriter& out, const NetHeader& h) {
+    out.u8(PK_SNAPSHOT);
+    out.varint((uint64_t)h.tick);
+    out.varint(h.baseline ? (uint64_t)(h.tick - h.baseline) : 0);
+    out.varint(h.inputSeq);
+    out.u8((uint8_t)(h.gameState | h.mode << 4));
+    out.u8((uint8_t)(h.hasShield | h.alive << 1));
+    for (int v : { h.score, h.ammo, h.nukes, h.health, h.maxHealth, h.wave, h.enemiesLeft, h.combo }) out.zigzag(v);
+    out.f32(h.survivalTime);
+    out.u8((uint8_t)h.slot);
+    out.f32(h.shipPos.x);
+    out.f32(h.shipPos.y);
+    out.f32(h.dashCooldown);
+    out.u8(h.ships);
+    for (int i = 0; i < MAX_PLAYERS; i++)
+        if (h.ships & (1 << i)) {
+            out.i16(fixed(h.shipPositions[i].x, 8));
+            out.i16(fixed(h.shipPositions[i].y, 8));
+        }
+}
+
+bool readSnapshotHeader(ByteReader& in, NetHeader& h) {
+    h.tick = (long)in.varint();
+    long back = (long)in.varint();
+    h.baseline = back ? h.tick - back : 0;
+    h.inputSeq = (uint32_t)in.varint();
+    uint8_t state = in.u8(), flags = in.u8();
+    h.gameState = (GameState)(state & 15);
+    h.mode = (GameMode)(state >> 4);
+    h.hasShield = flags & 1;
+    h.alive = flags & 2;
+    for (int* v : { &h.score, &h.ammo, &h.nukes, &h.health, &h.maxHealth, &h.wave, &h.enemiesLeft, &h.combo })
+        *v = (int)in.zigzag();
+    h.survivalTime = in.f32();
+    h.slot = in.u8();
+    h.shipPos.x = in.f32();
+    h.shipPos.y = in.f32();
+    h.dashCooldown = in.f32();
+    h.ships = in.u8();
+    for (int i = 0; i < MAX_PLAYERS; i++)
+        if (h.ships & (1 << i)) {
+            h.shipPositions[i].x = in.i16() / 8.0f;
+            h.shipPositions[i].y = in.i16() / 8.0f;
+        }
+    return in.ok && h.slot < MAX_PLAYERS && h.baseline >= 0;
+}
+
+size_t NetView::entities() const {
+    size_t n = 0;
+    for (const std::vector<NetEntity>& p : pools) n += p.size();
+    return n;
+}
+
+uint32_t viewChecksum(const NetView& v) {
+    uint32_t h = 2166136261u;
+    auto mix = [&](uint32_t x) {
+        for (int i = 0; i < 4; i++) h = (h ^ ((x >> (8 * i)) & 0xff)) * 16777619u;
+    };
+    for (const std::vector<NetEntity>& pool : v.pools) {
+        mix((uint32_t)pool.size());
+        for (const NetEntity& e : pool) {
+            mix(e.id);
+            mix((uint16_t)e.x | (uint32_t)(uint16_t)e.y << 16);
+            mix((uint16_t)e.vx | (uint32_t)(uint16_t)e.vy << 16);
+            mix(e.kind | (uint32_t)e.health << 8);
+        }
+    }
+    return h;
+}
+
+static NetEntity quantize(const World& w, int pool, uint32_t i) {
+    NetEntity n = {};
+    Vec2 pos = {}, vel = {};
+    switch (pool) {
+    case NET_ENEMIES: {
+        const Enemies& e = w.enemies;
+        n.id = e.id[i]; pos = e.pos[i]; vel = e.vel[i];
+        n.kind = (uint8_t)e.type[i];
+        n.health = (uint8_t)std::max(0, std::min(255, e.health[i]));
+        break;
+    }
+    case NET_BULLETS: n.id = w.bullets.id[i]; pos = w.bullets.pos[i]; vel = w.bullets.vel[i]; break;
+    case NET_AMMO: n.id = w.ammoBoxes.id[i]; pos = w.ammoBoxes.pos[i]; break;
+    default: n.id = w.powerUps.id[i]; pos = w.powerUps.pos[i]; n.kind = (uint8_t)w.powerUps.type[i]; break;
+    }
+    n.x = fixed(pos.x, 8); n.y = fixed(pos.y, 8);
+    n.vx = fixed(vel.x, 16); n.vy = fixed(vel.y, 16);
+    return n;
+}
+
+enum { F_X = 1, F_Y = 2, F_VX = 4, F_VY = 8, F_KIND = 16, F_HEALTH = 32 };
+
+static void writePool(ByteWriter& out, const std::vector<NetEntity>& pool, const std::vector<NetEntity>* base) {
+    static const NetEntity none = {};
+    out.varint(pool.size());
+    uint32_t prev = 0;
+    size_t j = 0;
+    for (const NetEntity& e : pool) {
+        out.varint(e.id - prev);
+        prev = e.id;
+        while (base && j < base->size() && (*base)[j].id < e.id) j++;
+        const NetEntity& b = base && j < base->size() && (*base)[j].id == e.id ? (*base)[j] : none;
+        uint8_t mask = (e.x != b.x ? F_X : 0) | (e.y != b.y ? F_Y : 0) | (e.vx != b.vx ? F_VX : 0) |
+                       (e.vy != b.vy ? F_VY : 0) | (e.kind != b.kind ? F_KIND : 0) | (e.health != b.health ? F_HEALTH : 0);
+        out.u8(mask);
+        if (mask & F_X) out.zigzag(e.x - b.x);
+        if (mask & F_Y) out.zigzag(e.y - b.y);
+        if (mask & F_VX) out.zigzag(e.vx - b.vx);
+        if (mask & F_VY) out.zigzag(e.vy - b.vy);
+        if (mask & F_KIND) out.u8(e.kind);
+        if (mask & F_HEALTH) out.u8(e.health);
+    }
+}
+
+static bool readPool(ByteReader& in, std::vector<NetEntity>& pool, const std::vector<NetEntity>* base) {
+    static const NetEntity none = {};
+    size_t n = (size_t)in.varint();
+    // Every entity takes at least two bytes.
+    if (!in.ok || n > (in.size - in.pos) / 2) return false;
+    pool.resize(n);
+    uint32_t prev = 0;
+    size_t j = 0;
+    for (NetEntity& e : pool) {
+        e.id = prev + (uint32_t)in.varint();
+        prev = e.id;
+        while (base && j < base->size() && (*base)[j].id < e.id) j++;
+        const NetEntity& b = base && j < base->size() && (*base)[j].id == e.id ? (*base)[j] : none;
+        uint8_t mask = in.u8();
+        e.x = (int16_t)(b.x + (mask & F_X ? in.zigzag() : 0));
+        e.y = (int16_t)(b.y + (mask & F_Y ? in.zigzag() : 0));
+        e.vx = (int16_t)(b.vx + (mask & F_VX ? in.zigzag() : 0));
+        e.vy = (int16_t)(b.vy + (mask & F_VY ? in.zigzag() : 0));
+        e.kind = mask & F_KIND ? in.u8() : b.kind;
+        e.health = mask & F_HEALTH ? in.u8() : b.health;
+    }
+    return in.ok;
+}
+
+void Replicator::build(const World& w, const NetHeader& h, Vec2 from, const NetView* base, NetView& view, std::vector<uint8_t>& out) {
+    candidates.clear();
+    float r2 = radius * radius;
+    for (size_t i = 0; i < w.enemies.size(); i++) {
+        float d2 = dist2(w.enemies.pos[i], from);
+        if (d2 <= r2) candidates.push_back({ d2, NET_ENEMIES, (uint32_t)i, w.enemies.id[i] });
+    }
+    for (size_t i = 0; i < w.bullets.size(); i++) {
+        float d2 = dist2(w.bullets.pos[i], from);
+        if (d2 <= r2) candidates.push_back({ d2, NET_BULLETS, (uint32_t)i, w.bullets.id[i] });
+    }
+
+    // Start from a guess at what fits and shrink to the nearest n until the
+    // packet does; nth_element keeps each pass linear.
+    size_t n = std::min(candidates.size(), maxBytes / 3), end = candidates.size();
+    for (;;) {
+        if (n < end) std::nth_element(candidates.begin(), candidates.begin() + n, candidates.begin() + end,
+                                      [](const Candidate& a, const Candidate& b) { return a.d2 < b.d2; });
+        end = n;
+        std::sort(candidates.begin(), candidates.begin() + n,
+                  [](const Candidate& a, const Candidate& b) { return a.pool != b.pool ? a.pool < b.pool : a.id < b.id; });
+        view.tick = h.tick;
+        for (std::vector<NetEntity>& p : view.pools) p.clear();
+        for (size_t i = 0; i < n; i++) view.pools[candidates[i].pool].push_back(quantize(w, candidates[i].pool, candidates[i].index));
+        for (size_t i = 0; i < w.ammoBoxes.size(); i++) view.pools[NET_AMMO].push_back(quantize(w, NET_AMMO, (uint32_t)i));
+        for (size_t i = 0; i < w.powerUps.size(); i++) view.pools[NET_POWERUPS].push_back(quantize(w, NET_POWERUPS, (uint32_t)i));
+
+        out.clear();
+        ByteWriter wr{ out };
+        writeHeader(wr, h);
+        size_t header = out.size();
+        for (int p = 0; p < NET_POOLS; p++) writePool(wr, view.pools[p], base ? &base->pools[p] : nullptr);
+        wr.u32(viewChecksum(view));
+        if (out.size() <= maxBytes || n == 0) return;
+        size_t budget = maxBytes > header + 64 ? maxBytes - header - 64 : 0;
+        n = std::min(n - 1, (size_t)((double)n * budget / (out.size() - header)));
+    }
+}
+
+bool readSnapshotView(ByteReader& in, long tick, const NetView* base, NetView& view) {
+    view.tick = tick;
+    for (int p = 0; p < NET_POOLS; p++)
+        if (!readPool(in, view.pools[p], base ? &base->pools[p] : nullptr)) return false;
+    uint32_t check = in.u32();
+    return in.ok && check == viewChecksum(view);
+}
+
+void applyView(const NetView& view, World& w) {
+    w.enemies.clear(); w.bullets.clear(); w.ammoBoxes.clear(); w.powerUps.clear();
+    for (const NetEntity& e : view.pools[NET_ENEMIES]) {
+        int type = std::min<int>(e.kind, ENEMY_TYPES - 1);
+        int i = w.enemies.add(type);
+        if (i < 0) break;
+        w.enemies.pos[i] = { e.x / 8.0f, e.y / 8.0f };
+        w.enemies.vel[i] = { e.vx / 16.0f, e.vy / 16.0f };
+        w.enemies.radius[i] = ENEMY_TRAITS[type].radius;
+        w.enemies.health[i] = e.health;
+        w.enemies.type[i] = (EnemyType)type;
+        w.enemies.id[i] = e.id;
+    }
+    for (const NetEntity& e : view.pools[NET_BULLETS]) {
+        int i = w.bullets.add();
+        if (i < 0) break;
+        w.bullets.pos[i] = { e.x / 8.0f, e.y / 8.0f };
+        w.bullets.vel[i] = { e.vx / 16.0f, e.vy / 16.0f };
+        w.bullets.id[i] = e.id;
+    }
+    for (const NetEntity& e : view.pools[NET_AMMO]) {
+        int i = w.ammoBoxes.add();
+        if (i < 0) break;
+        w.ammoBoxes.pos[i] = { e.x / 8.0f, e.y / 8.0f };
+        w.ammoBoxes.id[i] = e.id;
+    }
+    for (const NetEntity& e : view.pools[NET_POWERUPS]) {
+        int i = w.powerUps.add();
+        if (i < 0) break;
+        w.powerUps.pos[i] = { e.x / 8.0f, e.y / 8.0f };
+        w.powerUps.type[i] = e.kind;
+        w.powerUps.id[i] = e.id;
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "game.h"
+#include "net.h"
+
+// Co-op protocol. One authoritative server runs the World and up to
+// MAX_PLAYERS clients each fly one ship; client slot 0 is the player, slot
+// s > 0 is ally s - 1. Every packet starts with its PacketType byte.
+//   HELLO    client -> server: protocol version (u32), resent until answered.
+//   WELCOME  server -> client: slot (u8), tick rate (varint), seed (varint).
+//   FULL     server -> client: every slot is taken.
+//   INPUT    client -> server: newest snapshot tick decoded (varint), first
+//            input sequence number (varint), count (u8), then that many
+//            inputs. Unacknowledged inputs are resent with every packet.
+//   SNAPSHOT server -> client: a NetHeader, then the client's view of the
+//            entity pools delta-coded against a view it acknowledged,
+//            then a checksum of the decoded view (u32).
+//   BYE      client -> server: leaving.
+enum PacketType : uint8_t { PK_HELLO = 1, PK_WELCOME, PK_FULL, PK_INPUT, PK_SNAPSHOT, PK_BYE };
+const uint32_t COOP_PROTOCOL = 1;
+const int COOP_PORT = 27960;
+// Snapshots each side keeps to delta against; an acknowledgement older than
+// this gets a snapshot coded against nothing.
+const int COOP_HISTORY = 32;
+
+// Inputs travel as held buttons, actions and the aim in 1/16 px, six bytes.
+void writeNetInput(ByteWriter& out, const Input& in);
+Input readNetInput(ByteReader& in);
+// The input as the server will see it; clients predict with this.
+Input quantizeInput(const Input& in);
+
+// State sent whole in every snapshot: the shared team state, the receiving
+// client's own ship at full precision so it can reconcile its prediction,
+// and the other ships rounded to 1/8 px.
+struct NetHeader {
+    long tick = 0, baseline = 0;  // baseline 0: the view is coded against nothing
+    uint32_t inputSeq = 0;        // the client's last input applied this tick, 0 = none yet
+    GameState gameState = MENU;
+    GameMode mode = CLASSIC;
+    bool hasShield = false;
+    int score = 0, ammo = 0, nukes = 0, health = 0, maxHealth = 0, wave = 0, enemiesLeft = 0, combo = 0;
+    float survivalTime = 0;
+    int slot = 0;
+    Vec2 shipPos = {};
+    float dashCooldown = 0;
+    bool alive = false;
+    uint8_t ships = 0;  // bit per joined slot
+    Vec2 shipPositions[MAX_PLAYERS] = {};
+};
+
+// Fills everything in h but tick, baseline and inputSeq from w, as seen by slot.
+void fillHeader(const World& w, int slot, NetHeader& h);
+
+// A replicated entity: position in 1/8 px, velocity in 1/16 px per tick,
+// enemy or power-up type in kind.
+struct NetEntity { uint32_t id; int16_t x, y, vx, vy; uint8_t kind, health; };
+
+enum NetPool { NET_ENEMIES, NET_BULLETS, NET_AMMO, NET_POWERUPS, NET_POOLS };
+
+// The entities one client was sent for one tick, each pool sorted by id.
+struct NetView {
+    long tick = 0;
+    std::vector<NetEntity> pools[NET_POOLS];
+    size_t entities() const;
+};
+
+uint32_t viewChecksum(const NetView& v);
+
+// Server side. Interest management: a client sees every pickup and the
+// enemies and bullets within radius of its ship, nearest first, as many as
+// fit in maxBytes. Each entity is coded as its id gap, a mask of changed
+// fields and zigzag deltas against the same id in the baseline view, so an
+// enemy that only moved costs four or five bytes.
+class Replicator {
+public:
+    float radius = 400;
+    size_t maxBytes = 1200;
+
+    // Writes h and the view of w from `from` into out; view receives what was
+    // sent, to be kept as a later baseline. base must be the view for
+    // h.baseline, or null when h.baseline is 0.
+    void build(const World& w, const NetHeader& h, Vec2 from, const NetView* base, NetView& view, std::vector<uint8_t>& out);
+
+private:
+    struct Candidate { float d2; uint8_t pool; uint32_t index, id; };
+    std::vector<Candidate> candidates;
+};
+
+// Client side, after the PacketType byte: read the header, look up the view
+// for h.baseline, then read the view. False on a malformed packet or, for
+// the view, a checksum mismatch.
+bool readSnapshotHeader(ByteReader& in, NetHeader& h);
+bool readSnapshotView(ByteReader& in, long tick, const NetView* base, NetView& view);
+
+// Rebuilds w's pools from a decoded view, for a client's bot or renderer.
+void applyView(const NetView& view, World& w);
@@ -0,0 +1,19 @@
+#pragma once
+#include "vec2.h"
+
+// Side effects of a tick (scoring, combo, damage, pickups, shake, particles)
+// are queued as events by the simulation and applied together at the end of
+// the tick by resolveEvents().
+enum GameEventType {
+    EV_ENEMY_HIT,       // arg = number of bullets that hit
+    EV_ENEMY_KILLED,    // arg = number of killing blows
+    EV_NUKE_KILL,
+    EV_PLAYER_HIT,
+    EV_SHIELD_BROKEN,   // a player hit absorbed by the shield
+    EV_AMMO_PICKUP,
+    EV_POWERUP_PICKUP,  // arg = power-up type
+    EV_NUKE,
+    EV_DASH
+};
+
+struct GameEvent { GameEventType type; Vec2 pos; int arg; };
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "vec2.h"
+
+// Distance and unit direction from every cell to the nearest of up to
+// MAX_TARGETS targets (the ships), shared by every enemy. The arena has no
+// obstacles, so the distance is straight-line between cell centres and each
+// cell points at the centre of its nearest target's cell; a rebuild costs
+// cells * targets and only happens when some target changes cell. Close to
+// that target, and outside the arena where clamped cells would point the
+// wrong way, sample() steers straight at its exact position.
+struct FlowField {
+    static const int MAX_TARGETS = 8;
+    float cellSize = 20, invCell = 1.0f / 20;
+    int cols = 0, rows = 0;
+    int targets = 0;
+    int targetX[MAX_TARGETS] = {}, targetY[MAX_TARGETS] = {};
+    Vec2 targetPos[MAX_TARGETS] = {};
+    std::vector<Vec2> dir;
+    std::vector<float> dist;
+    std::vector<uint8_t> nearest;
+
+    FlowField(float width, float height, float cell) {
+        cellSize = cell;
+        invCell = 1.0f / cell;
+        cols = std::max(1, (int)ceil(width * invCell));
+        rows = std::max(1, (int)ceil(height * invCell));
+        dir.assign(cols * rows, { 0, 0 });
+        dist.assign(cols * rows, 0);
+        nearest.assign(cols * rows, 0);
+    }
+
+    bool inside(int cx, int cy) const { return cx >= 0 && cx < cols && cy >= 0 && cy < rows; }
+    // Forces a rebuild on the next update().
+    void invalidate() { targets = 0; }
+
+    // Takes this tick's target positions; returns true if one changed cell
+    // and the field was rebuilt.
+    bool update(const Vec2* pos, int count) {
+        count = std::min(count, MAX_TARGETS);
+        bool same = count == targets;
+        for (int t = 0; t < count; t++) {
+            int tx = (int)floor(pos[t].x * invCell), ty = (int)floor(pos[t].y * invCell);
+            same = same && tx == targetX[t] && ty == targetY[t];
+            targetX[t] = tx;
+            targetY[t] = ty;
+            targetPos[t] = pos[t];
+        }
+        targets = count;
+        if (same) return false;
+        for (int cy = 0; cy < rows; cy++)
+            for (int cx = 0; cx < cols; cx++) {
+                int c = cy * cols + cx, best = 0;
+                float bestD2 = 0;
+                for (int t = 0; t < count; t++) {
+                    float dx = (float)(targetX[t] - cx), dy = (float)(targetY[t] - cy), d2 = dx * dx + dy * dy;
+                    if (t == 0 || d2 < bestD2) { best = t; bestD2 = d2; }
+                }
+                nearest[c] = (uint8_t)best;
+                dist[c] = sqrtf(bestD2) * cellSize;
+                dir[c] = normalize({ (targetX[best] - cx) * cellSize, (targetY[best] - cy) * cellSize });
+            }
+        return true;
+    }
+
+    Vec2 sample(Vec2 p) const {
+        int cx = (int)floor(p.x * invCell), cy = (int)floor(p.y * invCell);
+        int c = std::max(0, std::min(rows - 1, cy)) * cols + std::max(0, std::min(cols - 1, cx));
+        int t = nearest[c];
+        if (!inside(cx, cy) || (abs(cx - targetX[t]) <= 1 && abs(cy - targetY[t]) <= 1))
+            return normalize({ targetPos[t].x - p.x, targetPos[t].y - p.y });
+        return dir[c];
+    }
+};
@@ -0,0 +1,650 @@
+#include "game.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+// Per-tick decay factor f applied over k ticks.
+static float decay(float f, float k) { return k == 1 ? f : powf(f, k); }
+
+// Emits n particles flying out of pos in random directions.
+static void burst(World& w, Vec2 pos, int n, float speed, float radius) {
+    for (int i = 0; i < n; i++) {
+        float a = w.fxRng.range(360) * 3.14159f / 180;
+        w.particles.emit(pos, { cosf(a) * speed, sinf(a) * speed }, radius);
+    }
+}
+
+static Vec2 moveDir(const Input& in) {
+    Vec2 dir = { 0, 0 };
+    if (in.up) dir.y += 1;
+    if (in.down) dir.y -= 1;
+    if (in.left) dir.x -= 1;
+    if (in.right) dir.x += 1;
+    return dir;
+}
+
+void seedWorld(World& w, uint64_t seed) {
+    w.seed = seed;
+    w.rng.seed(seed, 1);
+    w.fxRng.seed(seed, 2);
+}
+
+void allocateWorld(World& w) {
+    const WorldConfig& c = w.config;
+    w.bullets.reserve(c.maxBullets); w.enemies.reserve(c.maxEnemies);
+    w.ammoBoxes.reserve(c.maxAmmoBoxes); w.powerUps.reserve(c.maxPowerUps);
+    w.particles.reserve(c.maxParticles);
+    w.enemyGrid.reserve(c.maxEnemies); w.enemyHits.reserve(c.maxEnemies);
+    // Bounded by one hit per bullet plus kill, nuke kill and contact per enemy.
+    w.events.reserve(c.maxBullets + 3 * c.maxEnemies + c.maxAmmoBoxes + c.maxPowerUps + 16);
+}
+
+// Allies start beside the player, alternating right and left.
+static void placeAlly(Ally& a, int slot) {
+    float side = slot % 2 ? -1.0f : 1.0f;
+    a.ship = { {400 + side * 40 * (slot / 2 + 1), 300}, {0, 0}, 10, true };
+    a.prev = a.ship.pos;
+    a.trail = {};
+    a.shootCooldown = a.dashCooldown = 0;
+}
+
+void resetGame(World& w) {
+    const WorldConfig& c = w.config;
+    allocateWorld(w);
+    w.player = { {400, 300}, {0, 0}, 10, true };
+    w.playerTrail = {};
+    for (int i = 0; i < MAX_PLAYERS - 1; i++)
+        if (w.allies[i].joined) placeAlly(w.allies[i], i);
+    w.flowField.invalidate();
+    w.bullets.clear(); w.enemies.clear(); w.particles.clear(); w.ammoBoxes.clear();
+    w.powerUps.clear();
+    bool horde = w.mode == HORDE;
+    w.score = 0; w.ammo = horde ? c.horde.startAmmo : 50; w.nukes = horde ? c.horde.startNukes : 0;
+    w.playerHealth = w.maxHealth = horde ? c.horde.startHealth : 3;
+    w.wave = 1; w.enemiesLeftInWave = waveSize(w, 1); w.comboCount = 0;
+    w.spawnTimer = w.ammoSpawnTimer = w.powerUpSpawnTimer = w.shootCooldown = 0;
+    w.dashCooldown = w.rapidFireTimer = w.waveTransitionTimer = w.comboTimer = 0;
+    w.screenShakeIntensity = w.survivalTime = w.slowMoTimer = w.trailTimer = 0;
+    w.hasShield = false;
+    w.gameState = PLAYING;
+}
+
+static void addScreenShake(World& w, float intensity) { w.screenShakeIntensity = intensity; }
+
+static void emit(World& w, GameEventType type, Vec2 pos, int arg = 0) { w.events.push_back({ type, pos, arg }); }
+
+static bool tooCloseToPlayer(const World& w, float x, float y, float minDist) {
+    return dist2({ x, y }, w.player.pos) < minDist * minDist;
+}
+
+// The ship a circle moving from `from` to `to` this tick touches first, the
+// player on a tie, or null. Ships move from where they were before this
+// tick's move; a dash is a jump and is not swept.
+static const Ship* touchedShip(const World& w, Vec2 from, Vec2 to, float radius) {
+    const Ship* first = nullptr;
+    float earliest = 2, t;
+    auto test = [&](const Ship& ship, Vec2 prev) {
+        if (sweptHit(from - prev, to - ship.pos, radius + ship.radius, t) && t < earliest) { earliest = t; first = &ship; }
+    };
+    test(w.player, w.playerPrev);
+    for (const Ally& a : w.allies)
+        if (a.joined) test(a.ship, a.prev);
+    return first;
+}
+
+int joinAlly(World& w) {
+    for (int i = 0; i < MAX_PLAYERS - 1; i++) {
+        if (w.allies[i].joined) continue;
+        placeAlly(w.allies[i], i);
+        w.allies[i].ship.alive = w.player.alive;
+        w.allies[i].joined = true;
+        return i;
+    }
+    return -1;
+}
+
+void leaveAlly(World& w, int slot) { w.allies[slot].joined = false; }
+
+static void activateNuke(World& w, Vec2 at) {
+    if (w.nukes > 0) {
+        w.nukes--;
+        emit(w, EV_NUKE, at);
+        for (size_t i = 0; i < w.enemies.size(); i++)
+            if (w.enemies.alive(i)) emit(w, EV_NUKE_KILL, w.enemies.pos[i]);
+        w.enemies.clear();
+        // A horde wave keeps coming; in classic a nuke ends the wave.
+        if (w.mode == CLASSIC) w.enemiesLeftInWave = 0;
+    }
+}
+
+static bool dashShip(Ship& ship, float& cooldown, const Input& in) {
+    if (cooldown > 0) return false;
+    Vec2 dir = moveDir(in);
+    if (!(length(dir) > 0)) return false;
+    Vec2 dashDir = normalize(dir);
+    ship.pos = ship.pos + dashDir * 80.0f;
+    ship.pos.x = std::max(20.0f, std::min(780.0f, ship.pos.x));
+    ship.pos.y = std::max(20.0f, std::min(580.0f, ship.pos.y));
+    cooldown = 1.5f;
+    return true;
+}
+
+static void performDash(World& w, Ship& ship, float& cooldown, const Input& in) {
+    if (dashShip(ship, cooldown, in)) emit(w, EV_DASH, ship.pos);
+}
+
+static void moveShip(Ship& ship, const Input& in, float k) {
+    ship.vel = normalize(moveDir(in)) * 4.5f;
+    ship.pos = ship.pos + ship.vel * k;
+    ship.pos.x = std::max(20.0f, std::min(780.0f, ship.pos.x));
+    ship.pos.y = std::max(20.0f, std::min(580.0f, ship.pos.y));
+}
+
+void predictShip(Ship& ship, float& dashCooldown, const Input& in, float dt) {
+    if (in.dash) dashShip(ship, dashCooldown, in);
+    if (dashCooldown > 0) dashCooldown -= dt;
+    moveShip(ship, in, dt / TICK);
+}
+
+static void shootBullet(World& w, Vec2 from, float& cooldown, const Input& in) {
+    float fireRate = (w.rapidFireTimer > 0) ? 0.08f : 0.15f;
+    if (w.ammo > 0 && cooldown <= 0 && !w.bullets.full()) {
+        Vec2 dir = normalize({ in.aimX - from.x, in.aimY - from.y });
+        int b = w.bullets.add();
+        w.bullets.pos[b] = from;
+        w.bullets.vel[b] = dir * 12.0f;
+        w.bullets.id[b] = ++w.nextId;
+        w.ammo--;
+        cooldown = fireRate;
+    }
+}
+
+int waveSize(const World& w, int wave) {
+    if (w.mode == CLASSIC) return wave == 1 ? 5 : 5 + wave * 2;
+    const HordeConfig& h = w.config.horde;
+    return (int)std::min((float)h.maxWaveEnemies, h.baseEnemies * powf(h.growth, (float)(wave - 1)));
+}
+
+static Vec2 spawnPoint(World& w) {
+    float spawnX, spawnY;
+    do {
+        // Re-roll the angle too: with the player in a corner a fixed angle can
+        // have no radius far enough away and the loop never terminates.
+        float spawnAngle = w.rng.range(360) * 3.14159f / 180;
+        spawnX = 400 + cos(spawnAngle) * (350 + w.rng.range(150));
+        spawnY = 300 + sin(spawnAngle) * (250 + w.rng.range(150));
+    } while (tooCloseToPlayer(w, spawnX, spawnY, 200));
+    return { spawnX, spawnY };
+}
+
+static constexpr int spawnWeights() {
+    int total = 0;
+    for (const EnemyTraits& t : ENEMY_TRAITS) total += t.spawnWeight;
+    return total;
+}
+static_assert(spawnWeights() == 100, "enemy spawn weights are percentages");
+
+// No enemy moves faster than this per tick.
+static constexpr float maxEnemySpeed() {
+    float speed = 0;
+    for (const EnemyTraits& t : ENEMY_TRAITS) speed = std::max(speed, t.speed);
+    return speed;
+}
+
+static void addEnemy(World& w, Vec2 pos) {
+    EnemyType type = NORMAL;
+    int roll = w.rng.range(100);
+    for (int t = 0, weight = 0; t < ENEMY_TYPES; t++) {
+        weight += ENEMY_TRAITS[t].spawnWeight;
+        if (roll >= weight) continue;
+        if (w.wave >= ENEMY_TRAITS[t].firstWave) type = (EnemyType)t;
+        break;
+    }
+    const EnemyTraits& traits = ENEMY_TRAITS[type];
+    int health = traits.health;
+    if (w.wave >= 5 && (traits.lateChance >= 100 || w.rng.range(100) < traits.lateChance)) health = traits.lateHealth;
+
+    Enemies& e = w.enemies;
+    int i = e.add(type);
+    if (i < 0) return;
+    e.pos[i] = pos;
+    e.vel[i] = { 0, 0 };
+    e.radius[i] = traits.radius;
+    e.health[i] = health;
+    e.type[i] = type;
+    e.id[i] = ++w.nextId;
+}
+
+static void spawnEnemy(World& w) { addEnemy(w, spawnPoint(w)); }
+
+// Releases up to n enemies scattered around one spawn point; returns how many.
+static int spawnCluster(World& w, int n) {
+    Vec2 center = spawnPoint(w);
+    float spread = w.config.horde.clusterSpread;
+    int spawned = 0;
+    for (; spawned < n && !w.enemies.full(); spawned++) {
+        float dx = (w.rng.range(2001) - 1000) * 0.001f * spread;
+        float dy = (w.rng.range(2001) - 1000) * 0.001f * spread;
+        addEnemy(w, { center.x + dx, center.y + dy });
+    }
+    return spawned;
+}
+
+int waveAmmo(const World& w) { return w.mode == HORDE ? w.config.horde.ammoPerWave : 20; }
+int waveNukes(int wave) { return wave % 3 == 0 ? 1 : 0; }
+
+static void startNextWave(World& w) {
+    w.wave++;
+    w.enemiesLeftInWave = waveSize(w, w.wave);
+    w.waveTransitionTimer = 3.0f;
+    w.gameState = WAVE_TRANSITION;
+    w.ammo += waveAmmo(w);
+    w.nukes += waveNukes(w.wave);
+}
+
+static const Input IDLE;
+
+static void handleActions(World& w, const Input& in, const Input* allyInputs) {
+    switch (w.gameState) {
+    case MENU:
+        if (in.start || in.horde) {
+            w.mode = in.horde ? HORDE : CLASSIC;
+            resetGame(w);
+        }
+        break;
+    case PLAYING:
+        if (in.restart) { resetGame(w); break; }
+        if (in.nuke) activateNuke(w, w.player.pos);
+        if (in.pause) w.gameState = PAUSED;
+        if (in.dash) performDash(w, w.player, w.dashCooldown, in);
+        for (int i = 0; i < MAX_PLAYERS - 1 && w.gameState == PLAYING; i++) {
+            Ally& a = w.allies[i];
+            const Input& ai = allyInputs ? allyInputs[i] : IDLE;
+            if (!a.joined) continue;
+            if (ai.nuke) activateNuke(w, a.ship.pos);
+            if (ai.dash) performDash(w, a.ship, a.dashCooldown, ai);
+        }
+        break;
+    case PAUSED:
+        if (in.pause) w.gameState = PLAYING;
+        break;
+    case GAME_OVER:
+        if (in.restart) resetGame(w);
+        else if (in.menu) w.gameState = MENU;
+        break;
+    default:
+        break;
+    }
+}
+
+static void scoreKill(World& w) {
+    w.score += 10 * (w.comboCount / 5 + 1);
+    w.comboCount++; w.comboTimer = 3.0f;
+}
+
+// Applies the tick's queued events in the order they happened: first the
+// gameplay effects, then screen shake and particle bursts in one pass.
+static void resolveEvents(World& w) {
+    for (GameEvent& ev : w.events) {
+        switch (ev.type) {
+        case EV_ENEMY_KILLED:
+            for (int i = 0; i < ev.arg; i++) scoreKill(w);
+            break;
+        case EV_NUKE_KILL:
+            scoreKill(w);
+            break;
+        case EV_PLAYER_HIT:
+            if (w.hasShield) { w.hasShield = false; ev.type = EV_SHIELD_BROKEN; break; }
+            w.playerHealth--;
+            w.comboCount = 0;
+            if (w.playerHealth <= 0) {
+                w.player.alive = false;
+                for (Ally& a : w.allies) a.ship.alive = false;
+                w.gameState = GAME_OVER;
+                if (w.score > w.highScore) w.highScore = w.score;
+            }
+            break;
+        case EV_AMMO_PICKUP:
+            w.ammo += 25;
+            break;
+        case EV_POWERUP_PICKUP:
+            if (ev.arg == 0) w.nukes++;
+            else if (ev.arg == 1) w.hasShield = true;
+            else if (ev.arg == 2) w.rapidFireTimer = 10.0f;
+            else if (ev.arg == 3) w.slowMoTimer = 8.0f;
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (const GameEvent& ev : w.events) {
+        switch (ev.type) {
+        case EV_ENEMY_HIT: burst(w, ev.pos, 8 * ev.arg, 3, 2); break;
+        case EV_ENEMY_KILLED: addScreenShake(w, 3); burst(w, ev.pos, 20 * ev.arg, 4, 3); break;
+        case EV_NUKE_KILL: burst(w, ev.pos, 15, 5, 4); break;
+        case EV_PLAYER_HIT: addScreenShake(w, 15); break;
+        case EV_SHIELD_BROKEN: addScreenShake(w, 8); burst(w, ev.pos, 30, 5, 3); break;
+        case EV_AMMO_PICKUP: burst(w, ev.pos, 15, 3, 2); break;
+        case EV_POWERUP_PICKUP: burst(w, ev.pos, 20, 4, 3); break;
+        case EV_NUKE: addScreenShake(w, 20); burst(w, ev.pos, 150, 10, 6); break;
+        case EV_DASH:
+            addScreenShake(w, 5);
+            for (int i = 0; i < 20; i++)
+                w.particles.emit(ev.pos, { (w.fxRng.range(100) - 50) / 10.0f, (w.fxRng.range(100) - 50) / 10.0f }, 3);
+            break;
+        }
+    }
+    w.events.clear();
+}
+
+static void simulate(World& w, const Input& in, const Input* allyInputs, float dt);
+
+void step(World& w, const Input& in, float dt, const Input* allyInputs) {
+    float k = dt / TICK;
+    handleActions(w, in, allyInputs);
+
+    if (w.screenShakeIntensity > 0) {
+        w.screenShakeX = (w.fxRng.range(100) - 50) / 50.0f * w.screenShakeIntensity;
+        w.screenShakeY = (w.fxRng.range(100) - 50) / 50.0f * w.screenShakeIntensity;
+        w.screenShakeIntensity *= decay(0.9f, k);
+        if (w.screenShakeIntensity < 0.1f) w.screenShakeIntensity = w.screenShakeX = w.screenShakeY = 0;
+    }
+
+    bool simulated = false;
+    if (w.gameState == WAVE_TRANSITION) {
+        w.waveTransitionTimer -= dt;
+        if (w.waveTransitionTimer <= 0) w.gameState = PLAYING;
+    }
+    else if (w.gameState == PLAYING) {
+        simulate(w, in, allyInputs, dt);
+        simulated = true;
+    }
+
+    PhaseLaps laps(w.profiler);
+    resolveEvents(w);
+    laps.lap(PH_EVENTS);
+    if (simulated) {
+        w.particles.update(k, decay(0.97f, k), decay(0.96f, k), 0.3f);
+        laps.lap(PH_PARTICLES);
+    }
+}
+
+// Candidates looked at per enemy. Bounds the cost in dense crowds, where the
+// nearest few already give a usable push.
+const int MAX_NEIGHBOURS = 16;
+
+// Every enemy follows the shared flow field and is pushed away from the
+// enemies it overlaps. Velocities are all computed from this tick's starting
+// positions before anyone moves, so the result does not depend on order.
+static void moveEnemies(World& w, float k) {
+    Enemies& e = w.enemies;
+    int count = (int)e.size();
+    if (!count) return;
+    // Enemies chase the nearest ship: the player and every ally in the game.
+    static_assert(FlowField::MAX_TARGETS >= MAX_PLAYERS, "every ship is a flow field target");
+    Vec2 targets[MAX_PLAYERS];
+    int targetCount = 0;
+    targets[targetCount++] = w.player.pos;
+    for (const Ally& a : w.allies)
+        if (a.joined) targets[targetCount++] = a.ship.pos;
+    w.flowField.update(targets, targetCount);
+    // As in the broadphase, a handful of enemies is cheaper to compare pairwise.
+    bool useGrid = count > 32;
+    if (useGrid) w.enemyGrid.build(count, [&](int i, Vec2& pos, float& r) {
+        pos = e.pos[i]; r = e.radius[i];
+        return true;
+    });
+
+    const Vec2* pos = e.pos.data();
+    const float* radius = e.radius.data();
+    float slowMult = (w.slowMoTimer > 0) ? 0.3f : 1.0f;
+    // One loop per type, with that type's radius and steering as constants.
+    forEachEnemyType([&](auto type) {
+        constexpr EnemyTraits s = ENEMY_TRAITS[decltype(type)::value];
+        for (int i = (int)e.begin(type), end = (int)e.end(type); i < end; i++) {
+            Vec2 p = pos[i];
+            Vec2 push = { 0, 0 };
+            int seen = 0;
+            auto visit = [&](int j) {
+                if (j == i) return true;
+                Vec2 o = pos[j];
+                float reach = s.radius + radius[j], d2 = dist2(p, o);
+                if (d2 < reach * reach) {
+                    float d = sqrtf(d2);
+                    // Exactly stacked enemies split along a per-index angle.
+                    Vec2 away = d > 0 ? Vec2{ (p.x - o.x) / d, (p.y - o.y) / d }
+                                      : Vec2{ cosf(i * 2.39996f), sinf(i * 2.39996f) };
+                    push = push + away * (1 - d / reach);
+                }
+                return ++seen < MAX_NEIGHBOURS;
+            };
+            if (useGrid) w.enemyGrid.queryWhile(p, s.radius + w.enemyGrid.maxRadius, visit);
+            else for (int j = 0; j < count && visit(j); j++) {}
+            Vec2 chase = w.flowField.sample(p);
+            Vec2 desired = chase * s.pursuit + push * s.separation;
+            e.vel[i] = normalize(desired) * s.speed * slowMult;
+        }
+    });
+    for (int i = 0; i < count; i++) e.pos[i] = e.pos[i] + e.vel[i] * k;
+}
+
+static void simulate(World& w, const Input& in, const Input* allyInputs, float dt) {
+    float k = dt / TICK;
+    PhaseLaps laps(w.profiler);
+    w.survivalTime += dt;
+    if (w.shootCooldown > 0) w.shootCooldown -= dt;
+    if (w.dashCooldown > 0) w.dashCooldown -= dt;
+    if (w.rapidFireTimer > 0) w.rapidFireTimer -= dt;
+    if (w.slowMoTimer > 0) w.slowMoTimer -= dt;
+    if (w.comboTimer > 0) w.comboTimer -= dt;
+    else w.comboCount = 0;
+
+    Ship& player = w.player;
+    if (in.fire && player.alive) shootBullet(w, player.pos, w.shootCooldown, in);
+
+    w.playerPrev = player.pos;
+    moveShip(player, in, k);
+
+    for (int i = 0; i < MAX_PLAYERS - 1; i++) {
+        Ally& a = w.allies[i];
+        if (!a.joined) continue;
+        const Input& ai = allyInputs ? allyInputs[i] : IDLE;
+        if (a.shootCooldown > 0) a.shootCooldown -= dt;
+        if (a.dashCooldown > 0) a.dashCooldown -= dt;
+        if (ai.fire && a.ship.alive) shootBullet(w, a.ship.pos, a.shootCooldown, ai);
+        a.prev = a.ship.pos;
+        moveShip(a.ship, ai, k);
+    }
+    laps.lap(PH_PLAYER);
+
+    // Bullets that leave the arena are dropped after collision, so one that
+    // hits an enemy on its way out still counts.
+    Bullets& bullets = w.bullets;
+    float bulletStep2 = 0;
+    for (size_t i = 0; i < bullets.size(); i++) {
+        Vec2& p = bullets.pos[i];
+        p = p + bullets.vel[i] * k;
+        bulletStep2 = std::max(bulletStep2, dist2(bullets.vel[i], { 0, 0 }));
+    }
+    laps.lap(PH_BULLETS);
+
+    if (w.enemiesLeftInWave > 0 && w.mode == HORDE) {
+        const HordeConfig& h = w.config.horde;
+        w.spawnTimer += dt;
+        if (w.spawnTimer > h.clusterInterval) {
+            w.spawnTimer = 0;
+            int n = std::min(w.enemiesLeftInWave, h.clusterSize + h.clusterGrowth * (w.wave - 1));
+            // A full pool holds the rest of the wave back until enemies die.
+            w.enemiesLeftInWave -= spawnCluster(w, n);
+        }
+    }
+    else if (w.enemiesLeftInWave > 0) {
+        w.spawnTimer += dt;
+        float spawnRate = std::max(0.3f, 1.0f - w.wave * 0.05f);
+        if (w.spawnTimer > spawnRate) {
+            w.spawnTimer = 0;
+            spawnEnemy(w);
+            w.enemiesLeftInWave--;
+        }
+    }
+
+    if (w.enemiesLeftInWave <= 0 && w.enemies.empty()) startNextWave(w);
+    laps.lap(PH_SPAWN);
+
+    moveEnemies(w, k);
+    laps.lap(PH_ENEMIES);
+
+    w.ammoSpawnTimer += dt;
+    if (w.ammoSpawnTimer > 8.0f) {
+        w.ammoSpawnTimer = 0;
+        Vec2 pos = { float(w.rng.range(700) + 50), float(w.rng.range(500) + 50) };
+        int b = w.ammoBoxes.add();
+        if (b >= 0) {
+            w.ammoBoxes.pos[b] = pos;
+            w.ammoBoxes.id[b] = ++w.nextId;
+        }
+    }
+    AmmoBoxes& boxes = w.ammoBoxes;
+    for (size_t i = 0; i < boxes.size(); i++) {
+        boxes.rotation[i] += 1.0f * k;
+        if (touchedShip(w, boxes.pos[i], boxes.pos[i], AMMO_RADIUS)) {
+            boxes.kill(i);
+            emit(w, EV_AMMO_PICKUP, boxes.pos[i]);
+        }
+    }
+
+    w.powerUpSpawnTimer += dt;
+    if (w.powerUpSpawnTimer > 20.0f) {
+        w.powerUpSpawnTimer = 0;
+        int type = w.rng.range(POWERUP_TYPES);
+        Vec2 pos = { float(w.rng.range(700) + 50), float(w.rng.range(500) + 50) };
+        int p = w.powerUps.add();
+        if (p >= 0) {
+            w.powerUps.pos[p] = pos;
+            w.powerUps.type[p] = type;
+            w.powerUps.id[p] = ++w.nextId;
+        }
+    }
+    PowerUps& powerUps = w.powerUps;
+    for (size_t i = 0; i < powerUps.size(); i++) {
+        powerUps.rotation[i] += 2.0f * k;
+        powerUps.pulse[i] += 0.1f * k;
+        if (touchedShip(w, powerUps.pos[i], powerUps.pos[i], POWERUP_RADIUS)) {
+            powerUps.kill(i);
+            emit(w, EV_POWERUP_PICKUP, powerUps.pos[i], powerUps.type[i]);
+        }
+    }
+    laps.lap(PH_PICKUPS);
+
+    // Bullets and enemies both moved in a straight line this tick, from pos -
+    // vel * k to pos, so each bullet is swept against each enemy and goes to
+    // the one it reaches first, the lowest id on a tie. Nothing tunnels
+    // through at low tick rates or in catch-up steps. A pair can only touch
+    // if their end positions are within reach plus the longest bullet and
+    // enemy steps, which rules out most candidates before the swept test.
+    // Small scenes skip the grid since rebuilding it costs more than the pairs.
+    Enemies& enemies = w.enemies;
+    int enemyCount = (int)enemies.size(), bulletCount = (int)bullets.size();
+    bool useGrid = enemyCount * bulletCount > 256;
+    w.enemyHits.assign(enemyCount, 0);
+    const Vec2* enemyPos = enemies.pos.data();
+    const Vec2* enemyVel = enemies.vel.data();
+    const float* enemyRadius = enemies.radius.data();
+    const uint32_t* enemyId = enemies.id.data();
+    float bulletStep = sqrtf(bulletStep2) * k, enemyStep = maxEnemySpeed() * k, slack = bulletStep + enemyStep;
+    if (useGrid) w.enemyGrid.build(enemyCount, [&](int i, Vec2& pos, float& r) {
+        pos = enemyPos[i]; r = enemyRadius[i];
+        return enemies.alive(i);
+    });
+    for (int j = 0; j < bulletCount; j++) {
+        if (!bullets.alive(j)) continue;
+        Vec2 b = bullets.pos[j], step = bullets.vel[j] * k, start = b - step;
+        int owner = enemyCount;
+        uint32_t ownerId = UINT32_MAX;
+        float ownerT = 2, t;
+        auto test = [&](int i) {
+            Vec2 e = enemyPos[i];
+            float reach = enemyRadius[i] + BULLET_RADIUS, bound = reach + slack;
+            if (dist2(b, e) > bound * bound) return;
+            if (sweptHit(start - (e - enemyVel[i] * k), b - e, reach, t) && (t < ownerT || (t == ownerT && enemyId[i] < ownerId))) {
+                owner = i; ownerId = enemyId[i]; ownerT = t;
+            }
+        };
+        if (useGrid) w.enemyGrid.query(b - step * 0.5f, BULLET_RADIUS + w.enemyGrid.maxRadius + bulletStep * 0.5f + enemyStep, test);
+        else for (int i = 0; i < enemyCount; i++) if (enemies.alive(i)) test(i);
+        if (owner < enemyCount) { bullets.kill(j); w.enemyHits[owner]++; }
+        else if (b.x < 0 || b.x > ARENA_W || b.y < 0 || b.y > ARENA_H) bullets.kill(j);
+    }
+
+    for (int i = 0; i < enemyCount; i++) {
+        if (!enemies.alive(i)) continue;
+        int hits = w.enemyHits[i];
+        if (hits > 0) {
+            // Every hit that leaves health at or below zero scores, as it
+            // always has when several bullets land on one enemy in a tick.
+            int& health = enemies.health[i];
+            int kills = std::min(hits, std::max(0, hits - health + 1));
+            health -= hits;
+            emit(w, EV_ENEMY_HIT, enemyPos[i], hits);
+            if (kills > 0) { enemies.kill(i); emit(w, EV_ENEMY_KILLED, enemyPos[i], kills); }
+        }
+        const Ship* hit = enemies.alive(i) ? touchedShip(w, enemyPos[i] - enemyVel[i] * k, enemyPos[i], enemyRadius[i]) : nullptr;
+        if (hit) {
+            enemies.kill(i);
+            emit(w, EV_PLAYER_HIT, hit->pos);
+        }
+    }
+    laps.lap(PH_COLLISION);
+
+    bullets.flush();
+    enemies.flush();
+    boxes.flush();
+    powerUps.flush();
+    laps.lap(PH_COMPACT);
+
+    // Trails take a point for every TICK of game time, each placed where its
+    // emitter was at that moment of the tick, so they span the same time at
+    // any tick rate. trailTimer ends as the age of the newest point.
+    for (w.trailTimer += dt; w.trailTimer >= TICK; w.trailTimer -= TICK) {
+        float ago = (w.trailTimer - TICK) / dt;  // fraction of the tick since the point
+        auto feed = [&](ShipTrail& t, const Ship& s, Vec2 prev) {
+            if (length(s.vel) > 0) t.push(s.pos + (prev - s.pos) * ago);
+            else t.shrink();
+        };
+        feed(w.playerTrail, player, w.playerPrev);
+        for (Ally& a : w.allies)
+            if (a.joined) feed(a.trail, a.ship, a.prev);
+        for (size_t i = 0; i < bullets.size(); i++) bullets.trail[i].push(bullets.pos[i] - bullets.vel[i] * (k * ago));
+    }
+    laps.lap(PH_TRAILS);
+}
+
+static uint64_t fnv(uint64_t h, const void* data, size_t n) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < n; i++) h = (h ^ p[i]) * 1099511628211ULL;
+    return h;
+}
+
+template <typename T>
+static uint64_t fnvValue(uint64_t h, const T& v) { return fnv(h, &v, sizeof(v)); }
+
+uint64_t hashWorld(const World& w) {
+    uint64_t h = 14695981039346656037ULL;
+    h = fnvValue(h, w.rng.state);
+    h = fnvValue(h, w.player.pos); h = fnvValue(h, w.player.alive);
+    for (const Ally& a : w.allies)
+        if (a.joined) h = fnvValue(h, a.ship.pos);
+    int ints[] = { w.score, w.ammo, w.nukes, w.playerHealth, w.wave, w.enemiesLeftInWave, w.comboCount, (int)w.gameState, w.hasShield, (int)w.mode };
+    h = fnv(h, ints, sizeof(ints));
+    float timers[] = { w.spawnTimer, w.ammoSpawnTimer, w.powerUpSpawnTimer, w.shootCooldown, w.dashCooldown,
+                       w.rapidFireTimer, w.waveTransitionTimer, w.comboTimer, w.survivalTime, w.slowMoTimer };
+    h = fnv(h, timers, sizeof(timers));
+    const Bullets& b = w.bullets;
+    for (size_t i = 0; i < b.size(); i++) { h = fnvValue(h, b.pos[i]); h = fnvValue(h, b.vel[i]); }
+    const Enemies& e = w.enemies;
+    for (size_t i = 0; i < e.size(); i++) { h = fnvValue(h, e.pos[i]); h = fnvValue(h, e.health[i]); h = fnvValue(h, e.type[i]); }
+    for (Vec2 pos : w.ammoBoxes.pos) h = fnvValue(h, pos);
+    for (size_t i = 0; i < w.powerUps.size(); i++) { h = fnvValue(h, w.powerUps.pos[i]); h = fnvValue(h, w.powerUps.type[i]); }
+    return h;
+}
@@ -0,0 +1,203 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "vec2.h"
+#include "spatial_grid.h"
+#include "flow_field.h"
+#include "particles.h"
+#include "archetype.h"
+#include "events.h"
+#include "rng.h"
+#include "profiler.h"
+
+struct Ship { Vec2 pos, vel; float radius; bool alive; };
+
+// The last N positions of a moving emitter, one per TICK of game time, drawn
+// as a single strip tapering away from it. The ring is fixed, so a trail
+// costs the same however long it is.
+template <int N>
+struct TrailRing {
+    Vec2 points[N] = {};
+    uint8_t head = 0, count = 0;
+    void push(Vec2 p) {
+        points[head] = p;
+        head = (head + 1) % N;
+        if (count < N) count++;
+    }
+    // Drops the oldest point, so a trail that is no longer fed shrinks away.
+    void shrink() { if (count > 0) count--; }
+    // back 0 is the newest point.
+    Vec2 at(int back) const { return points[(head + N - 1 - back) % N]; }
+};
+using BulletTrail = TrailRing<8>;
+using ShipTrail = TrailRing<16>;
+
+enum GameState { MENU, PLAYING, PAUSED, GAME_OVER, WAVE_TRANSITION };
+enum EnemyType { NORMAL, FAST, TANK, ENEMY_TYPES };
+enum GameMode { CLASSIC, HORDE };
+
+// What sets an enemy type apart; a new type only needs an entry in
+// ENEMY_TRAITS. From firstWave on, spawnWeight in 100 spawns are of the type
+// (the weights add up to 100); before it those spawns are NORMAL. From wave
+// 5, lateChance in 100 spawn with lateHealth.
+struct EnemyTraits {
+    float radius;
+    int health, lateHealth, lateChance;
+    int firstWave, spawnWeight;
+    float speed, pursuit, separation;  // tanks shove harder, fast enemies slip through crowds
+    float r, g, b;
+};
+
+constexpr EnemyTraits ENEMY_TRAITS[ENEMY_TYPES] = {
+    { 12, 1, 2, 30, 1, 40, 2.0f, 1.0f, 1.0f, 1, 0, 0 },       // NORMAL
+    { 10, 1, 2, 30, 3, 30, 2.8f, 1.0f, 0.6f, 1, 0.5f, 0 },    // FAST
+    { 15, 2, 3, 100, 3, 30, 1.2f, 1.0f, 1.6f, 0.8f, 0, 0.8f },  // TANK
+};
+
+// Calls f(std::integral_constant<EnemyType, T>()) for each type in order, so
+// f can read ENEMY_TRAITS[T] as constants.
+template <typename F, size_t... T>
+void forEachEnemyType(F f, std::index_sequence<T...>) { (f(std::integral_constant<EnemyType, (EnemyType)T>()), ...); }
+template <typename F>
+void forEachEnemyType(F f) { forEachEnemyType(f, std::make_index_sequence<ENEMY_TYPES>()); }
+
+// Bullets, enemies and pickups are archetypes: one column per component.
+// id numbers each in spawn order (World::nextId); replication matches
+// entities across ticks by it. Enemies are grouped by type, every other
+// archetype stays sorted by id.
+const float BULLET_RADIUS = 4, AMMO_RADIUS = 15, POWERUP_RADIUS = 18;
+const int POWERUP_TYPES = 4;
+
+struct Bullets : Archetype<Bullets> {
+    std::vector<Vec2> pos, vel;
+    std::vector<uint32_t> id;
+    std::vector<BulletTrail> trail;
+    template <typename S, typename F>
+    static void columns(S& s, F f) { f(s.pos); f(s.vel); f(s.id); f(s.trail); }
+};
+
+struct Enemies : GroupedArchetype<Enemies, ENEMY_TYPES> {
+    std::vector<Vec2> pos, vel;
+    std::vector<float> radius;
+    std::vector<int> health;
+    std::vector<EnemyType> type;
+    std::vector<uint32_t> id;
+    template <typename S, typename F>
+    static void columns(S& s, F f) { f(s.pos); f(s.vel); f(s.radius); f(s.health); f(s.type); f(s.id); }
+    int group(size_t row) const { return type[row]; }
+};
+
+struct AmmoBoxes : Archetype<AmmoBoxes> {
+    std::vector<Vec2> pos;
+    std::vector<float> rotation;
+    std::vector<uint32_t> id;
+    template <typename S, typename F>
+    static void columns(S& s, F f) { f(s.pos); f(s.rotation); f(s.id); }
+};
+
+struct PowerUps : Archetype<PowerUps> {
+    std::vector<Vec2> pos;
+    std::vector<float> rotation, pulse;
+    std::vector<int> type;  // 0 nuke, 1 shield, 2 rapid fire, 3 slow-mo
+    std::vector<uint32_t> id;
+    template <typename S, typename F>
+    static void columns(S& s, F f) { f(s.pos); f(s.rotation); f(s.pulse); f(s.type); f(s.id); }
+};
+
+// Co-op: player is ship 0 and allies are ships 1 to MAX_PLAYERS - 1. The team
+// shares score, ammo, nukes and health; each ship moves, shoots, dashes and
+// picks things up on its own, and enemies chase the nearest ship.
+const int MAX_PLAYERS = 8;
+struct Ally { Ship ship; Vec2 prev; ShipTrail trail; float shootCooldown, dashCooldown; bool joined; };
+
+// Gameplay constants were tuned for a 16 ms tick; per-tick speeds are scaled by dt / TICK.
+const float TICK = 0.016f;
+const float ARENA_W = 800, ARENA_H = 600;
+
+// Everything the simulation reads from the player for one tick. Held state is
+// sampled, the remaining flags are one-shot actions that fire once per tick.
+struct Input {
+    bool up = false, down = false, left = false, right = false;
+    bool fire = false;
+    float aimX = 400, aimY = 300;
+    bool start = false, restart = false, menu = false, pause = false;
+    bool dash = false, nuke = false, horde = false;  // start starts classic, horde starts horde mode
+};
+
+// Capacities of the entity pools. They are allocated once by resetGame() and
+// never grow, so the game loop itself makes no heap allocations.
+// Horde waves: wave n holds baseEnemies * growth^(n-1) enemies, up to
+// maxWaveEnemies, released as clusters of clusterSize + clusterGrowth * (n-1)
+// enemies every clusterInterval seconds.
+struct HordeConfig {
+    int baseEnemies = 400, maxWaveEnemies = 12000;
+    float growth = 1.6f;
+    int clusterSize = 48, clusterGrowth = 16;
+    float clusterInterval = 0.2f, clusterSpread = 45;
+    int startHealth = 5, startAmmo = 400, ammoPerWave = 300, startNukes = 1;
+};
+
+struct WorldConfig {
+    int maxBullets = 2048, maxEnemies = 16384, maxAmmoBoxes = 32, maxPowerUps = 32;
+    int maxParticles = 1 << 17;
+    HordeConfig horde;
+};
+
+// New gameplay state must also be added to the snapshot format (snapshot.cpp).
+struct World {
+    WorldConfig config;
+    uint64_t seed = 0;
+    Rng rng, fxRng;  // gameplay rolls / particles and screen shake
+    Ship player = { {400, 300}, {0, 0}, 10, true };
+    Vec2 playerPrev = { 400, 300 };  // before this tick's move; the renderer interpolates from it
+    ShipTrail playerTrail;
+    Bullets bullets;
+    ParticleSystem particles;
+    Enemies enemies;
+    AmmoBoxes ammoBoxes;
+    PowerUps powerUps;
+
+    int score = 0, highScore = 0, ammo = 50, nukes = 0, playerHealth = 3, maxHealth = 3;
+    int wave = 1, enemiesLeftInWave = 5, comboCount = 0;
+    float spawnTimer = 0, ammoSpawnTimer = 0, powerUpSpawnTimer = 0, shootCooldown = 0;
+    float dashCooldown = 0, rapidFireTimer = 0, waveTransitionTimer = 0, comboTimer = 0;
+    float screenShakeX = 0, screenShakeY = 0, screenShakeIntensity = 0, survivalTime = 0;
+    float slowMoTimer = 0, trailTimer = 0;
+    bool hasShield = false;
+    uint32_t nextId = 0;
+    Ally allies[MAX_PLAYERS - 1] = {};
+    GameState gameState = MENU;
+    GameMode mode = CLASSIC;  // of the current game; resetGame() keeps it
+
+    std::vector<GameEvent> events;
+    Profiler* profiler = nullptr;  // per-phase timing of step() when set
+
+    // Enemy steering; enemyGrid is rebuilt for separation before enemies
+    // move and again for the bullet/enemy broadphase after.
+    FlowField flowField{ ARENA_W, ARENA_H, 20 };
+    SpatialGrid enemyGrid{ ARENA_W, ARENA_H, 20 };
+    std::vector<int> enemyHits;
+};
+
+// Seeds both random streams; the same seed and inputs replay the same game.
+void seedWorld(World& w, uint64_t seed);
+// Sizes every pool from w.config; resetGame() and snapshot loading call it.
+void allocateWorld(World& w);
+void resetGame(World& w);
+// Enemies in the given wave of the current mode.
+int waveSize(const World& w, int wave);
+// Ammo and nukes granted on reaching a new wave (the given one for nukes).
+int waveAmmo(const World& w);
+int waveNukes(int wave);
+// allyInputs, when given, holds one input per ally slot; allies that have
+// joined stand still without it. Only the player's input drives the menus.
+void step(World& w, const Input& in, float dt, const Input* allyInputs = nullptr);
+// Adds a ship to the game; returns its ally slot, or -1 if all are taken.
+int joinAlly(World& w);
+void leaveAlly(World& w, int slot);
+// A ship's own movement for one PLAYING tick: dash, dash cooldown, move.
+// step() does exactly this, so clients use it to predict their ship.
+void predictShip(Ship& ship, float& dashCooldown, const Input& in, float dt);
+// Hash of the gameplay state, for checking that replays are bit-exact.
+uint64_t hashWorld(const World& w);
@@ -0,0 +1,257 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <thread>
+#include "game.h"
+#include "alloc_counter.h"
+#include "replay.h"
+#include "bot.h"
+#include "run_history.h"
+#include "snapshot.h"
+
+// One volley played at several tick rates: a ring of enemies of every type
+// closing on the player, with one bullet fired from the centre at each.
+// Returns how many were shot down in the first second. Every bullet is
+// aimed dead centre, so the count should be the ring size at any rate.
+const int VOLLEY_ENEMIES = 36;
+
+static int volleyHits(int tickRate) {
+    World w;
+    seedWorld(w, 1);
+    resetGame(w);
+    w.enemiesLeftInWave = 1;
+    w.spawnTimer = -1e9f;
+    w.ammoSpawnTimer = w.powerUpSpawnTimer = -1e9f;
+    for (int i = 0; i < VOLLEY_ENEMIES; i++) {
+        EnemyType type = (EnemyType)(i % ENEMY_TYPES);
+        float a = i * 6.2832f / VOLLEY_ENEMIES;
+        Vec2 dir = { cosf(a), sinf(a) };
+        int e = w.enemies.add(type);
+        w.enemies.pos[e] = w.player.pos + dir * 280.0f;
+        w.enemies.radius[e] = ENEMY_TRAITS[type].radius;
+        w.enemies.health[e] = 1;
+        w.enemies.type[e] = type;
+        w.enemies.id[e] = ++w.nextId;
+        int b = w.bullets.add();
+        w.bullets.pos[b] = w.player.pos;
+        w.bullets.vel[b] = dir * 12.0f;
+        w.bullets.id[b] = ++w.nextId;
+    }
+    for (int t = 0; t < tickRate; t++) step(w, Input(), 1.0f / tickRate);
+    return VOLLEY_ENEMIES - (int)w.enemies.size();
+}
+
+// Half a second of a bullet and the player flying right at one tick rate.
+// Sets how far back each one's trail reaches, which should not depend on
+// the rate.
+static void trailSpans(int tickRate, float& bulletSpan, float& shipSpan) {
+    World w;
+    seedWorld(w, 1);
+    resetGame(w);
+    w.enemiesLeftInWave = 1;
+    w.spawnTimer = -1e9f;
+    w.ammoSpawnTimer = w.powerUpSpawnTimer = -1e9f;
+    int b = w.bullets.add();
+    w.bullets.pos[b] = { 100, 100 };
+    w.bullets.vel[b] = { 12, 0 };
+    w.bullets.id[b] = ++w.nextId;
+    Input right;
+    right.right = true;
+    for (int t = 0; t < tickRate / 2; t++) step(w, right, 1.0f / tickRate);
+    const BulletTrail& bt = w.bullets.trail[0];
+    bulletSpan = length(w.bullets.pos[0] - bt.at(bt.count - 1));
+    shipSpan = length(w.player.pos - w.playerTrail.at(w.playerTrail.count - 1));
+}
+
+int main(int argc, char** argv) {
+    long ticks = 100000;
+    uint64_t seed = 1;
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    const char* tracePath = nullptr;
+    const char* historyDir = nullptr;
+    const char* loadPath = nullptr;
+    const char* savePath = nullptr;
+    long saveTick = -1;
+    bool rewind = false;
+    bool horde = false;
+    bool rateCheck = false;
+    int tickRate = 60;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--ticks") && i + 1 < argc) ticks = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--record") && i + 1 < argc) recordPath = argv[++i];
+        else if (!strcmp(argv[i], "--replay") && i + 1 < argc) replayPath = argv[++i];
+        else if (!strcmp(argv[i], "--trace") && i + 1 < argc) tracePath = argv[++i];
+        else if (!strcmp(argv[i], "--history") && i + 1 < argc) historyDir = argv[++i];
+        else if (!strcmp(argv[i], "--load-snapshot") && i + 1 < argc) loadPath = argv[++i];
+        else if (!strcmp(argv[i], "--save-snapshot") && i + 2 < argc) { saveTick = atol(argv[++i]); savePath = argv[++i]; }
+        else if (!strcmp(argv[i], "--rewind")) rewind = true;
+        else if (!strcmp(argv[i], "--horde")) horde = true;
+        else if (!strcmp(argv[i], "--rate-check")) rateCheck = true;
+        else if (!strcmp(argv[i], "--tick-rate") && i + 1 < argc) tickRate = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--ticks N] [--seed S] [--record FILE | --replay FILE] [--trace FILE] [--history DIR] [--horde] [--tick-rate HZ]\n"
+                            "       [--load-snapshot FILE] [--save-snapshot TICK FILE] [--rewind] [--rate-check]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (rateCheck) {
+        static const int rates[] = { 15, 20, 30, 60, 120, 240 };
+        bool same = true;
+        for (int rate : rates) {
+            int hits = volleyHits(rate);
+            printf("%3d Hz  bullet step %4.1f px  enemies shot %d of %d\n", rate, 12.0f / (TICK * rate), hits, VOLLEY_ENEMIES);
+            same &= hits == VOLLEY_ENEMIES;
+        }
+        printf("%s\n", same ? "hit counts match at every tick rate" : "HIT COUNTS DIFFER");
+        static const int trailRates[] = { 30, 60, 120 };
+        float bullet0 = 0, ship0 = 0;
+        bool spans = true;
+        for (int rate : trailRates) {
+            float bullet, ship;
+            trailSpans(rate, bullet, ship);
+            if (rate == trailRates[0]) { bullet0 = bullet; ship0 = ship; }
+            printf("%3d Hz  bullet trail %5.1f px  ship trail %5.1f px\n", rate, bullet, ship);
+            spans &= fabsf(bullet - bullet0) < 0.5f && fabsf(ship - ship0) < 0.5f;
+        }
+        printf("%s\n", spans ? "trail spans match at every tick rate" : "TRAIL SPANS DIFFER");
+        return same && spans ? 0 : 1;
+    }
+
+    // A replay supplies its own seed and tick length and runs to its end.
+    ReplayPlayer replay;
+    ReplayRecorder recorder;
+    if (tickRate <= 0) { fprintf(stderr, "--tick-rate must be positive\n"); return 1; }
+    float dt = 1.0f / tickRate;
+    if (replayPath) {
+        if (!replay.open(replayPath)) { fprintf(stderr, "cannot read replay %s\n", replayPath); return 1; }
+        seed = replay.seed;
+        dt = replay.dt;
+    }
+    else if (recordPath && !recorder.open(recordPath, seed, dt)) {
+        fprintf(stderr, "cannot write replay %s\n", recordPath);
+        return 1;
+    }
+
+    RunHistory history;
+    if (historyDir) {
+        history.replayRef = recordPath ? recordPath : replayPath ? replayPath : "";
+        history.open(historyDir);
+    }
+
+    World world;
+    seedWorld(world, seed);
+    // The autopilot cannot dodge a horde; keep it alive so the waves keep growing.
+    if (horde) world.config.horde.startHealth = 1 << 30;
+    Profiler profiler;
+    if (tracePath) {
+        profiler.threadName = "simulation";
+        profiler.startTrace(1 << 20);
+        world.profiler = &profiler;
+    }
+    // A snapshot continues the session at its tick; a replay skips the ticks before it.
+    long startTick = 0;
+    if (loadPath) {
+        if (recordPath) { fprintf(stderr, "--record cannot start from a snapshot\n"); return 1; }
+        if (!readSnapshotFile(loadPath, world, startTick)) { fprintf(stderr, "cannot load snapshot %s\n", loadPath); return 1; }
+        Input skipped;
+        for (long t = 0; replayPath && t < startTick; t++) replay.next(skipped);
+    }
+    // Once a second of game time, like the game; checked by replaying from the oldest at the end.
+    RewindBuffer rewinds;
+    long rewindEvery = std::max(1L, std::lround(1 / dt));
+    int games = 0, bestWave = 0, bestScore = 0;
+    size_t peakEnemies = 0;
+    FrameBudget budget;
+    long long allocsAtStart = loadPath ? heapAllocations() : -1;
+    auto t0 = std::chrono::steady_clock::now();
+    long t = startTick;
+    for (; replayPath || t < ticks; t++) {
+        Input in;
+        if (!replayPath) in = autopilot(world, t, horde);
+        else if (!replay.next(in)) break;
+        if (recorder.isOpen()) in = recorder.record(in);
+
+        GameState before = world.gameState;
+        // Only horde runs pay for timing every tick; classic ticks are far below budget.
+        std::chrono::steady_clock::time_point tickStart;
+        if (horde) tickStart = std::chrono::steady_clock::now();
+        {
+            ScopedPhase tickTimer(world.profiler, PH_TICK);
+            step(world, in, dt);
+        }
+        if (horde) budget.check(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - tickStart).count());
+        if (world.enemies.size() > peakEnemies) peakEnemies = world.enemies.size();
+        // The first resetGame() sizes the pools; count everything after it.
+        if (allocsAtStart < 0 && before == MENU) allocsAtStart = heapAllocations();
+        if (before != GAME_OVER && world.gameState == GAME_OVER) {
+            games++;
+            // The queue holds 64 runs; wait for the writer rather than drop one.
+            while (historyDir && !history.submit(world, t + 1)) std::this_thread::yield();
+        }
+        if (world.wave > bestWave) bestWave = world.wave;
+        if (world.score > bestScore) bestScore = world.score;
+        if (t + 1 == saveTick && !writeSnapshotFile(savePath, world, t + 1)) { fprintf(stderr, "cannot write %s\n", savePath); return 1; }
+        if (rewind && (t + 1) % rewindEvery == 0) rewinds.capture(world, t + 1);
+    }
+    recorder.close();
+    history.stop();
+    const Profiler* threads[] = { &profiler };
+    if (tracePath && !writeChromeTrace(tracePath, threads, 1)) {
+        fprintf(stderr, "cannot write trace %s\n", tracePath);
+        return 1;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    long ran = t - startTick;
+    printf("ticks %ld  sim time %.1fs  wall %.3fs  %.0f ticks/s\n", ran, ran * dt, secs, ran / secs);
+    printf("games over %d  best wave %d  best score %d  peak enemies %zu\n", games, bestWave, bestScore, peakEnemies);
+    if (horde) printf("ticks over %.0f ms budget %ld  worst tick %.2f ms\n", budget.budgetMs, budget.overruns, budget.worstMs);
+    long long allocs = heapAllocations() - allocsAtStart;
+    printf("heap allocations after first reset %lld (%.4f per tick)\n", allocs, (double)allocs / ran);
+    printf("seed %llu  world hash %016llx\n", (unsigned long long)seed, (unsigned long long)hashWorld(world));
+    if (rewind && rewinds.size()) {
+        printf("rewind snapshots %ld  capture mean %.1f us  worst %.1f us  held %zu in %zu bytes\n", rewinds.captures,
+               rewinds.totalNs / 1e3 / rewinds.captures, rewinds.worstNs / 1e3, rewinds.size(), rewinds.bytes());
+        // The autopilot is a function of the world and tick, so rerunning it
+        // from a restored snapshot must end in the same state.
+        long at;
+        World again;
+        if (!replayPath && !recordPath && rewinds.restore(rewinds.size() - 1, again, at)) {
+            auto r0 = std::chrono::steady_clock::now();
+            for (long u = at; u < t; u++) step(again, autopilot(again, u, horde), dt);
+            printf("rewound %ld ticks (restore + replay %.1f ms): %s\n", t - at,
+                   std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - r0).count(),
+                   hashWorld(again) == hashWorld(world) ? "hash matches" : "HASH MISMATCH");
+        }
+        // Damaged snapshots must be turned down, leaving the world as it was.
+        void (*damage[])(World&) = {
+            [](World& b) { b.config.maxBullets = -5; },
+            [](World& b) { b.config.maxEnemies = 1 << 30; },
+            [](World& b) { b.playerTrail.head = 200; },
+            [](World& b) { b.allies[0].trail.count = 17; },
+            [](World& b) { uint8_t v = 7; memcpy(&b.allies[0].joined, &v, 1); },
+            [](World& b) { b.gameState = (GameState)99; },
+            [](World& b) { int r = b.bullets.add(); if (r >= 0) b.bullets.trail[r].head = 8; },
+            [](World& b) { int r = b.powerUps.add(); if (r >= 0) b.powerUps.type[r] = POWERUP_TYPES; },
+        };
+        std::vector<uint8_t> bad;
+        uint64_t before = hashWorld(again);
+        int accepted = 0;
+        for (auto hurt : damage) {
+            World broken = world;
+            hurt(broken);
+            saveSnapshot(broken, t, bad);
+            accepted += loadSnapshot(again, bad.data(), bad.size(), at);
+        }
+        bool untouched = hashWorld(again) == before;
+        printf("%s\n", !accepted && untouched ? "damaged snapshots rejected" : "DAMAGED SNAPSHOT LOADED");
+        if (accepted || !untouched) return 1;
+    }
+    return 0;
+}
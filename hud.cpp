@@ -0,0 +1,190 @@
+#include "hud.h"
+#include <GL/gl.h>
+#include <algorithm>
+#include "hud_font.h"
+#include "renderer.h"
+
+const int ATLAS_W = 512, ATLAS_H = 128;
+const int FIRST_GLYPH = ' ', LAST_GLYPH = '~';
+
+struct GlyphRect { short x, y, w; };
+static GlyphRect glyphRects[2][LAST_GLYPH - FIRST_GLYPH + 1];
+
+static const BitmapFont& font(HudFont f) { return f == HUD_LARGE ? FONT_HELVETICA_18 : FONT_9X15; }
+
+// Packs both fonts into one alpha texture, rows bottom first like glBitmap.
+static unsigned buildAtlas() {
+    std::vector<unsigned char> texels(ATLAS_W * ATLAS_H, 0);
+    int x = 0, y = 0;
+    for (int f = HUD_SMALL; f <= HUD_LARGE; f++) {
+        const BitmapFont& bf = font((HudFont)f);
+        for (int c = FIRST_GLYPH; c <= LAST_GLYPH; c++) {
+            const unsigned char* g = bf.bits + bf.offsets[c - FIRST_GLYPH];
+            int w = g[0], rowBytes = (w + 7) / 8;
+            if (x + w > ATLAS_W) { x = 0; y += bf.height + 1; }
+            glyphRects[f][c - FIRST_GLYPH] = { (short)x, (short)y, (short)w };
+            for (int r = 0; r < bf.height; r++)
+                for (int i = 0; i < w; i++)
+                    if (g[1 + r * rowBytes + i / 8] & (0x80 >> (i % 8))) texels[(y + r) * ATLAS_W + x + i] = 255;
+            x += w + 1;
+        }
+        x = 0;
+        y += bf.height + 1;
+    }
+
+    GLuint tex;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, ATLAS_W, ATLAS_H, 0, GL_ALPHA, GL_UNSIGNED_BYTE, texels.data());
+    return tex;
+}
+
+struct GlyphVertex { float x, y, u, v; unsigned char rgba[4]; };
+
+static unsigned char channel(float c) { return (unsigned char)(std::max(0.0f, std::min(1.0f, c)) * 255 + 0.5f); }
+
+// Quads placed where glutBitmapCharacter would have put each bitmap.
+static void layout(std::vector<GlyphVertex>& out, float x, float y, HudFont f, const float* rgb, const char* text) {
+    const BitmapFont& bf = font(f);
+    unsigned char col[4] = { channel(rgb[0]), channel(rgb[1]), channel(rgb[2]), 255 };
+    float y0 = y - bf.descent, y1 = y0 + bf.height;
+    for (const char* c = text; *c; c++) {
+        if (*c < FIRST_GLYPH || *c > LAST_GLYPH) continue;
+        const GlyphRect& g = glyphRects[f][*c - FIRST_GLYPH];
+        float u0 = (float)g.x / ATLAS_W, u1 = (float)(g.x + g.w) / ATLAS_W;
+        float v0 = (float)g.y / ATLAS_H, v1 = (float)(g.y + bf.height) / ATLAS_H;
+        out.push_back({ x, y0, u0, v0, { col[0], col[1], col[2], col[3] } });
+        out.push_back({ x + g.w, y0, u1, v0, { col[0], col[1], col[2], col[3] } });
+        out.push_back({ x + g.w, y1, u1, v1, { col[0], col[1], col[2], col[3] } });
+        out.push_back({ x, y1, u0, v1, { col[0], col[1], col[2], col[3] } });
+        x += g.w;
+    }
+}
+
+Hud::Item& Hud::slot(Kind kind, float x, float y, float w, float h, float R, float G, float B, HudFont font) {
+    if (next == items.size()) {
+        items.emplace_back();
+        items.back().kind = (Kind)-1;
+    }
+    Item& it = items[next++];
+    if (it.kind != kind || it.x != x || it.y != y || it.w != w || it.h != h || it.rgb[0] != R || it.rgb[1] != G ||
+        it.rgb[2] != B || it.font != font) {
+        it = Item();
+        it.kind = kind;
+        it.x = x; it.y = y; it.w = w; it.h = h;
+        it.rgb[0] = R; it.rgb[1] = G; it.rgb[2] = B;
+        it.font = font;
+        dirty = true;
+    }
+    return it;
+}
+
+void Hud::compile() {
+    if (!atlas) atlas = buildAtlas();
+    if (!list) list = glGenLists(1);
+    static std::vector<GlyphVertex> glyphs;
+    glyphs.clear();
+
+    RenderStats before = renderStats;
+    renderStats = RenderStats();
+    glNewList(list, GL_COMPILE);
+    for (const Item& it : items) {
+        if (it.kind == TEXT) layout(glyphs, it.x, it.y, it.font, it.rgb, it.text);
+        else if (it.kind == RECT) drawRect(it.x, it.y, it.w, it.h, it.rgb[0], it.rgb[1], it.rgb[2]);
+        else drawHeart(it.x, it.y, 1, it.kind == HEART);
+    }
+    flushBatches();
+    if (!glyphs.empty()) {
+        glEnable(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, atlas);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(2, GL_FLOAT, sizeof(GlyphVertex), &glyphs[0].x);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(GlyphVertex), &glyphs[0].u);
+        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(GlyphVertex), glyphs[0].rgba);
+        glDrawArrays(GL_QUADS, 0, (GLsizei)glyphs.size());
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glDisable(GL_TEXTURE_2D);
+        renderStats.drawCalls++;
+        renderStats.vertices += (int)glyphs.size();
+    }
+    glEndList();
+    listDrawCalls = renderStats.drawCalls;
+    listVertices = renderStats.vertices;
+    renderStats = before;
+    dirty = false;
+    rebuilds++;
+}
+
+void Hud::end() {
+    if (next != items.size()) { items.resize(next); dirty = true; }
+    if (dirty) compile();
+    glCallList(list);
+    renderStats.drawCalls += listDrawCalls;
+    renderStats.vertices += listVertices;
+}
+
+void gameHud(Hud& hud, const RenderFrame& w) {
+    if (w.gameState == MENU) {
+        hud.text(300, 400, HUD_LARGE, 0, 1, 1, "GEOMETRY SHOOTER");
+        hud.button(300, 320, 200, 40, "START GAME (ENTER)", 0, 1, 0);
+        hud.button(300, 260, 200, 40, "QUIT (ESC)", 1, 0, 0);
+        hud.text(320, 200, HUD_SMALL, 1, 1, 0, "HIGH SCORE: %d", w.highScore);
+        hud.text(325, 160, HUD_SMALL, 1, 0.5f, 0, "H - HORDE MODE");
+        hud.text(200, 100, HUD_SMALL, 1, 1, 1, "Controls:");
+        hud.text(200, 80, HUD_SMALL, 0.8f, 0.8f, 0.8f, "WASD/Arrows - Move");
+        hud.text(200, 60, HUD_SMALL, 0.8f, 0.8f, 0.8f, "Mouse - Aim & Shoot");
+        hud.text(200, 40, HUD_SMALL, 0.8f, 0.8f, 0.8f, "E - Dash");
+        hud.text(200, 20, HUD_SMALL, 0.8f, 0.8f, 0.8f, "SPACE - Nuke");
+        return;
+    }
+
+    hud.text(10, 580, HUD_SMALL, 0, 1, 1, "SCORE: %d", w.score);
+    hud.text(10, 560, HUD_SMALL, 1, 1, 0, "AMMO: %d", w.ammo);
+    hud.text(10, 540, HUD_SMALL, 1, 0, 1, "NUKES: %d", w.nukes);
+    if (w.mode == HORDE) hud.text(10, 520, HUD_SMALL, 1, 0.5f, 0, "WAVE: %d  HORDE: %zu +%d", w.wave, w.enemies.size(), w.enemiesLeftInWave);
+    else hud.text(10, 520, HUD_SMALL, 1, 0.5f, 0, "WAVE: %d", w.wave);
+    hud.text(650, 580, HUD_SMALL, 0.8f, 0.8f, 0.8f, "TIME: %.1fs", w.survivalTime);
+
+    float heartsX = 795 - w.maxHealth * 25;
+    for (int i = 0; i < w.maxHealth; i++) hud.heart(heartsX + i * 25, 550, i < w.playerHealth);
+
+    if (w.comboCount > 0) hud.text(10, 490, HUD_LARGE, 1, 1, 0, "COMBO x%d", w.comboCount / 5 + 1);
+
+    if (w.dashCooldown > 0) hud.text(10, 470, HUD_SMALL, 0.6f, 0.6f, 1, "DASH: %.1fs", w.dashCooldown);
+    else hud.text(10, 470, HUD_SMALL, 0, 1, 0, "DASH: READY (E)");
+
+    if (w.rapidFireTimer > 0) hud.text(10, 450, HUD_SMALL, 1, 0.5f, 0, "RAPID FIRE: %.1fs", w.rapidFireTimer);
+    if (w.slowMoTimer > 0) hud.text(10, 430, HUD_SMALL, 0, 1, 1, "SLOW-MO: %.1fs", w.slowMoTimer);
+    if (w.hasShield) hud.text(10, 410, HUD_SMALL, 0, 0.8f, 1, "SHIELD ACTIVE");
+
+    if (w.gameState == WAVE_TRANSITION) {
+        hud.text(280, 350, HUD_LARGE, 0, 1, 0, "WAVE %d COMPLETE!", w.wave - 1);
+        hud.text(280, 320, HUD_LARGE, 1, 1, 0, "WAVE %d STARTING...", w.wave);
+        hud.text(300, 280, HUD_SMALL, 1, 1, 0, "+%d Ammo", w.waveAmmo);
+        if (w.waveNukes) hud.text(300, 260, HUD_SMALL, 1, 0, 1, "+%d Nuke", w.waveNukes);
+    }
+
+    if (w.gameState == PAUSED) {
+        hud.text(340, 350, HUD_LARGE, 1, 1, 1, "PAUSED");
+        hud.text(310, 310, HUD_SMALL, 0.8f, 0.8f, 0.8f, "Press P to Resume");
+    }
+
+    if (w.gameState == GAME_OVER) {
+        hud.text(320, 380, HUD_LARGE, 1, 0, 0, "GAME OVER");
+        hud.text(330, 350, HUD_SMALL, 1, 1, 1, "Final Score: %d", w.score);
+        hud.text(320, 330, HUD_SMALL, 0, 1, 1, "Waves Survived: %d", w.wave - 1);
+        hud.text(340, 310, HUD_SMALL, 1, 1, 0, "Time: %.1fs", w.survivalTime);
+        if (w.score == w.highScore && w.score > 0) hud.text(310, 280, HUD_SMALL, 1, 1, 0, "NEW HIGH SCORE!");
+        hud.button(325, 230, 150, 30, "RESTART (R)", 0, 1, 0);
+        hud.button(325, 190, 150, 30, "MENU (M)", 1, 1, 0);
+    }
+
+    if (w.overruns > 0) hud.text(10, 45, HUD_SMALL, 1, 0.3f, 0.3f, "SLOW TICKS: %ld (WORST %.1f MS)", w.overruns, w.worstTickMs);
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "render_frame.h"
+
+enum HudFont { HUD_SMALL, HUD_LARGE };  // GLUT's 9x15 and Helvetica 18
+
+// Retained HUD. Callers describe the whole HUD every frame between begin()
+// and end(), and items are matched to last frame's by position in that
+// sequence. A text item whose format and arguments are unchanged is not
+// formatted again; one whose formatted string is unchanged does not count as
+// a change. end() recompiles the HUD's display list only when some item
+// changed, and otherwise replays it. Text is drawn from a glyph atlas built
+// from embedded bitmap fonts, so no window system fonts are needed.
+class Hud {
+public:
+    int rebuilds = 0;  // display list recompiles so far
+
+    void begin() { next = 0; }
+
+    // fmt must be a string literal: unchanged items are matched by pointer.
+    template <typename... Args>
+    void text(float x, float y, HudFont font, float R, float G, float B, const char* fmt, Args... args) {
+        Item& it = slot(TEXT, x, y, 0, 0, R, G, B, font);
+        unsigned char key[KEY_BYTES];
+        int keyBytes = 0;
+        (pack(key, keyBytes, args), ...);
+        if (it.fmt == fmt && keyBytes <= KEY_BYTES && it.keyBytes == keyBytes && !memcmp(it.key, key, keyBytes)) return;
+
+        char buf[sizeof it.text];
+        if constexpr (sizeof...(args) == 0) snprintf(buf, sizeof buf, "%s", fmt);
+        else snprintf(buf, sizeof buf, fmt, args...);
+        it.fmt = fmt;
+        it.keyBytes = keyBytes;
+        if (keyBytes <= KEY_BYTES) memcpy(it.key, key, keyBytes);
+        if (strcmp(buf, it.text)) { strcpy(it.text, buf); dirty = true; }
+    }
+
+    void heart(float x, float y, bool filled) { slot(filled ? HEART : HEART_OUTLINE, x, y, 0, 0, 1, 0, 0, HUD_SMALL); }
+    void rect(float x, float y, float w, float h, float R, float G, float B) { slot(RECT, x, y, w, h, R, G, B, HUD_SMALL); }
+    void button(float x, float y, float w, float h, const char* label, float R, float G, float B) {
+        rect(x, y, w, h, R, G, B);
+        text(x + 20, y + 15, HUD_SMALL, R, G, B, label);
+    }
+
+    // Draws the HUD, recompiling it first if anything changed. Needs a GL context.
+    void end();
+
+private:
+    enum Kind { TEXT, HEART, HEART_OUTLINE, RECT };
+    static const int KEY_BYTES = 48;
+
+    struct Item {
+        Kind kind;
+        float x, y, w, h, rgb[3];
+        HudFont font;
+        const char* fmt;
+        int keyBytes;
+        unsigned char key[KEY_BYTES];
+        char text[96];
+    };
+
+    // Arguments longer than the key always fall through to formatting.
+    template <typename T>
+    static void pack(unsigned char* key, int& n, const T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "HUD arguments must be plain values");
+        if (n + (int)sizeof v <= KEY_BYTES) memcpy(key + n, &v, sizeof v);
+        n += sizeof v;
+    }
+
+    Item& slot(Kind kind, float x, float y, float w, float h, float R, float G, float B, HudFont font);
+    void compile();
+
+    std::vector<Item> items;
+    size_t next = 0;
+    bool dirty = true;
+    unsigned list = 0, atlas = 0;
+    int listDrawCalls = 0, listVertices = 0;
+};
+
+// The game's own HUD for a frame: the menu, or the score, status lines and
+// overlays while playing.
+void gameHud(Hud& hud, const RenderFrame& w);
@@ -0,0 +1,229 @@
+#pragma once
+
+// Glyph bitmaps for printable ASCII, copied from freeglut's X11 bitmap fonts so
+// the HUD looks as it did with glutBitmapCharacter. Each glyph is its advance
+// width followed by one row per line of height, bottom row first, with
+// (width + 7) / 8 bytes per row, most significant bit leftmost.
+
+struct BitmapFont {
+    int height, descent;
+    const unsigned char* bits;
+    const unsigned short* offsets;  // into bits, for ' ' to '~'
+};
+
+// -misc-fixed-medium-r-normal--15-140-75-75-C-90-iso8859-1
+static const unsigned char fixed9x15Bits[] = {
+    9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // space
+    9,0,0,0,0,0,0,0,0,8,0,8,0,0,0,0,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,0,0,  // !
+    9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,18,0,18,0,18,0,0,0,0,0,  // "
+    9,0,0,0,0,0,0,0,0,0,0,36,0,36,0,126,0,36,0,36,0,126,0,36,0,36,0,0,0,0,0,0,0,  // #
+    9,0,0,0,0,0,0,8,0,62,0,73,0,9,0,9,0,10,0,28,0,40,0,72,0,73,0,62,0,8,0,0,0,  // $
+    9,0,0,0,0,0,0,0,0,66,0,37,0,37,0,18,0,8,0,8,0,36,0,82,0,82,0,33,0,0,0,0,0,  // %
+    9,0,0,0,0,0,0,0,0,49,0,74,0,68,0,74,0,49,0,48,0,72,0,72,0,72,0,48,0,0,0,0,0,  // &
+    9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,16,0,8,0,4,0,6,0,0,0,0,0,  // '
+    9,0,0,0,0,0,0,4,0,8,0,8,0,16,0,16,0,16,0,16,0,16,0,16,0,8,0,8,0,4,0,0,0,  // (
+    9,0,0,0,0,0,0,16,0,8,0,8,0,4,0,4,0,4,0,4,0,4,0,4,0,8,0,8,0,16,0,0,0,  // )
+    9,0,0,0,0,0,0,0,0,0,0,8,0,73,0,42,0,28,0,42,0,73,0,8,0,0,0,0,0,0,0,0,0,  // *
+    9,0,0,0,0,0,0,0,0,0,0,8,0,8,0,8,0,127,0,8,0,8,0,8,0,0,0,0,0,0,0,0,0,  // +
+    9,0,0,8,0,4,0,4,0,12,0,12,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // ,
+    9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,127,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // -
+    9,0,0,0,0,0,0,0,0,12,0,12,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // .
+    9,0,0,0,0,0,0,0,0,64,0,32,0,32,0,16,0,8,0,8,0,4,0,2,0,2,0,1,0,0,0,0,0,  // /
+    9,0,0,0,0,0,0,0,0,28,0,34,0,65,0,65,0,65,0,65,0,65,0,65,0,34,0,28,0,0,0,0,0,  // 0
+    9,0,0,0,0,0,0,0,0,127,0,8,0,8,0,8,0,8,0,8,0,72,0,40,0,24,0,8,0,0,0,0,0,  // 1
+    9,0,0,0,0,0,0,0,0,127,0,64,0,32,0,16,0,8,0,4,0,2,0,65,0,65,0,62,0,0,0,0,0,  // 2
+    9,0,0,0,0,0,0,0,0,62,0,65,0,1,0,1,0,1,0,14,0,4,0,2,0,1,0,127,0,0,0,0,0,  // 3
+    9,0,0,0,0,0,0,0,0,2,0,2,0,2,0,127,0,66,0,34,0,18,0,10,0,6,0,2,0,0,0,0,0,  // 4
+    9,0,0,0,0,0,0,0,0,62,0,65,0,1,0,1,0,1,0,97,0,94,0,64,0,64,0,127,0,0,0,0,0,  // 5
+    9,0,0,0,0,0,0,0,0,62,0,65,0,65,0,65,0,97,0,94,0,64,0,64,0,32,0,30,0,0,0,0,0,  // 6
+    9,0,0,0,0,0,0,0,0,32,0,32,0,16,0,16,0,8,0,4,0,2,0,1,0,1,0,127,0,0,0,0,0,  // 7
+    9,0,0,0,0,0,0,0,0,28,0,34,0,65,0,65,0,34,0,28,0,34,0,65,0,34,0,28,0,0,0,0,0,  // 8
+    9,0,0,0,0,0,0,0,0,60,0,2,0,1,0,1,0,61,0,67,0,65,0,65,0,65,0,62,0,0,0,0,0,  // 9
+    9,0,0,0,0,0,0,0,0,12,0,12,0,0,0,0,0,0,0,12,0,12,0,0,0,0,0,0,0,0,0,0,0,  // :
+    9,0,0,8,0,4,0,4,0,12,0,12,0,0,0,0,0,0,0,12,0,12,0,0,0,0,0,0,0,0,0,0,0,  // ;
+    9,0,0,0,0,0,0,0,0,2,0,4,0,8,0,16,0,32,0,32,0,16,0,8,0,4,0,2,0,0,0,0,0,  // <
+    9,0,0,0,0,0,0,0,0,0,0,0,0,127,0,0,0,0,0,127,0,0,0,0,0,0,0,0,0,0,0,0,0,  // =
+    9,0,0,0,0,0,0,0,0,32,0,16,0,8,0,4,0,2,0,2,0,4,0,8,0,16,0,32,0,0,0,0,0,  // >
+    9,0,0,0,0,0,0,0,0,8,0,0,0,8,0,8,0,4,0,2,0,1,0,65,0,65,0,62,0,0,0,0,0,  // ?
+    9,0,0,0,0,0,0,0,0,62,0,64,0,64,0,77,0,83,0,81,0,79,0,65,0,65,0,62,0,0,0,0,0,  // @
+    9,0,0,0,0,0,0,0,0,65,0,65,0,65,0,127,0,65,0,65,0,65,0,34,0,20,0,8,0,0,0,0,0,  // A
+    9,0,0,0,0,0,0,0,0,126,0,33,0,33,0,33,0,33,0,126,0,33,0,33,0,33,0,126,0,0,0,0,0,  // B
+    9,0,0,0,0,0,0,0,0,62,0,65,0,64,0,64,0,64,0,64,0,64,0,64,0,65,0,62,0,0,0,0,0,  // C
+    9,0,0,0,0,0,0,0,0,126,0,33,0,33,0,33,0,33,0,33,0,33,0,33,0,33,0,126,0,0,0,0,0,  // D
+    9,0,0,0,0,0,0,0,0,127,0,32,0,32,0,32,0,32,0,60,0,32,0,32,0,32,0,127,0,0,0,0,0,  // E
+    9,0,0,0,0,0,0,0,0,32,0,32,0,32,0,32,0,32,0,60,0,32,0,32,0,32,0,127,0,0,0,0,0,  // F
+    9,0,0,0,0,0,0,0,0,62,0,65,0,65,0,65,0,71,0,64,0,64,0,64,0,65,0,62,0,0,0,0,0,  // G
+    9,0,0,0,0,0,0,0,0,65,0,65,0,65,0,65,0,65,0,127,0,65,0,65,0,65,0,65,0,0,0,0,0,  // H
+    9,0,0,0,0,0,0,0,0,62,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,62,0,0,0,0,0,  // I
+    9,0,0,0,0,0,0,0,0,60,0,66,0,2,0,2,0,2,0,2,0,2,0,2,0,2,0,15,128,0,0,0,0,  // J
+    9,0,0,0,0,0,0,0,0,65,0,66,0,68,0,72,0,80,0,112,0,72,0,68,0,66,0,65,0,0,0,0,0,  // K
+    9,0,0,0,0,0,0,0,0,127,0,64,0,64,0,64,0,64,0,64,0,64,0,64,0,64,0,64,0,0,0,0,0,  // L
+    9,0,0,0,0,0,0,0,0,65,0,65,0,65,0,73,0,73,0,85,0,85,0,99,0,65,0,65,0,0,0,0,0,  // M
+    9,0,0,0,0,0,0,0,0,65,0,65,0,65,0,67,0,69,0,73,0,81,0,97,0,65,0,65,0,0,0,0,0,  // N
+    9,0,0,0,0,0,0,0,0,62,0,65,0,65,0,65,0,65,0,65,0,65,0,65,0,65,0,62,0,0,0,0,0,  // O
+    9,0,0,0,0,0,0,0,0,64,0,64,0,64,0,64,0,64,0,126,0,65,0,65,0,65,0,126,0,0,0,0,0,  // P
+    9,0,0,0,0,3,0,4,0,62,0,73,0,81,0,65,0,65,0,65,0,65,0,65,0,65,0,62,0,0,0,0,0,  // Q
+    9,0,0,0,0,0,0,0,0,65,0,65,0,66,0,68,0,72,0,126,0,65,0,65,0,65,0,126,0,0,0,0,0,  // R
+    9,0,0,0,0,0,0,0,0,62,0,65,0,65,0,1,0,6,0,56,0,64,0,65,0,65,0,62,0,0,0,0,0,  // S
+    9,0,0,0,0,0,0,0,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,127,0,0,0,0,0,  // T
+    9,0,0,0,0,0,0,0,0,62,0,65,0,65,0,65,0,65,0,65,0,65,0,65,0,65,0,65,0,0,0,0,0,  // U
+    9,0,0,0,0,0,0,0,0,8,0,20,0,20,0,20,0,34,0,34,0,34,0,65,0,65,0,65,0,0,0,0,0,  // V
+    9,0,0,0,0,0,0,0,0,34,0,85,0,73,0,73,0,73,0,73,0,65,0,65,0,65,0,65,0,0,0,0,0,  // W
+    9,0,0,0,0,0,0,0,0,65,0,65,0,34,0,20,0,8,0,8,0,20,0,34,0,65,0,65,0,0,0,0,0,  // X
+    9,0,0,0,0,0,0,0,0,8,0,8,0,8,0,8,0,8,0,8,0,20,0,34,0,65,0,65,0,0,0,0,0,  // Y
+    9,0,0,0,0,0,0,0,0,127,0,64,0,64,0,32,0,16,0,8,0,4,0,2,0,1,0,127,0,0,0,0,0,  // Z
+    9,0,0,0,0,0,0,30,0,16,0,16,0,16,0,16,0,16,0,16,0,16,0,16,0,16,0,16,0,30,0,0,0,  // [
+    9,0,0,0,0,0,0,0,0,1,0,2,0,2,0,4,0,8,0,8,0,16,0,32,0,32,0,64,0,0,0,0,0,  // backslash
+    9,0,0,0,0,0,0,60,0,4,0,4,0,4,0,4,0,4,0,4,0,4,0,4,0,4,0,4,0,60,0,0,0,  // ]
+    9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,65,0,34,0,20,0,8,0,0,0,0,0,  // ^
+    9,0,0,0,0,0,0,255,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // _
+    9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,8,0,16,0,48,0,0,0,  // `
+    9,0,0,0,0,0,0,0,0,61,0,67,0,65,0,63,0,1,0,1,0,62,0,0,0,0,0,0,0,0,0,0,0,  // a
+    9,0,0,0,0,0,0,0,0,94,0,97,0,65,0,65,0,65,0,97,0,94,0,64,0,64,0,64,0,0,0,0,0,  // b
+    9,0,0,0,0,0,0,0,0,62,0,65,0,64,0,64,0,64,0,65,0,62,0,0,0,0,0,0,0,0,0,0,0,  // c
+    9,0,0,0,0,0,0,0,0,61,0,67,0,65,0,65,0,65,0,67,0,61,0,1,0,1,0,1,0,0,0,0,0,  // d
+    9,0,0,0,0,0,0,0,0,62,0,64,0,64,0,127,0,65,0,65,0,62,0,0,0,0,0,0,0,0,0,0,0,  // e
+    9,0,0,0,0,0,0,0,0,16,0,16,0,16,0,16,0,124,0,16,0,16,0,17,0,17,0,14,0,0,0,0,0,  // f
+    9,0,0,62,0,65,0,65,0,62,0,64,0,60,0,66,0,66,0,66,0,61,0,0,0,0,0,0,0,0,0,0,0,  // g
+    9,0,0,0,0,0,0,0,0,65,0,65,0,65,0,65,0,65,0,97,0,94,0,64,0,64,0,64,0,0,0,0,0,  // h
+    9,0,0,0,0,0,0,0,0,62,0,8,0,8,0,8,0,8,0,8,0,56,0,0,0,0,0,24,0,0,0,0,0,  // i
+    9,0,0,60,0,66,0,66,0,66,0,2,0,2,0,2,0,2,0,2,0,14,0,0,0,0,0,6,0,0,0,0,0,  // j
+    9,0,0,0,0,0,0,0,0,65,0,70,0,88,0,96,0,88,0,70,0,65,0,64,0,64,0,64,0,0,0,0,0,  // k
+    9,0,0,0,0,0,0,0,0,62,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,56,0,0,0,0,0,  // l
+    9,0,0,0,0,0,0,0,0,65,0,73,0,73,0,73,0,73,0,73,0,118,0,0,0,0,0,0,0,0,0,0,0,  // m
+    9,0,0,0,0,0,0,0,0,65,0,65,0,65,0,65,0,65,0,97,0,94,0,0,0,0,0,0,0,0,0,0,0,  // n
+    9,0,0,0,0,0,0,0,0,62,0,65,0,65,0,65,0,65,0,65,0,62,0,0,0,0,0,0,0,0,0,0,0,  // o
+    9,0,0,64,0,64,0,64,0,94,0,97,0,65,0,65,0,65,0,97,0,94,0,0,0,0,0,0,0,0,0,0,0,  // p
+    9,0,0,1,0,1,0,1,0,61,0,67,0,65,0,65,0,65,0,67,0,61,0,0,0,0,0,0,0,0,0,0,0,  // q
+    9,0,0,0,0,0,0,0,0,32,0,32,0,32,0,32,0,33,0,49,0,78,0,0,0,0,0,0,0,0,0,0,0,  // r
+    9,0,0,0,0,0,0,0,0,62,0,65,0,1,0,62,0,64,0,65,0,62,0,0,0,0,0,0,0,0,0,0,0,  // s
+    9,0,0,0,0,0,0,0,0,14,0,17,0,16,0,16,0,16,0,16,0,126,0,16,0,16,0,0,0,0,0,0,0,  // t
+    9,0,0,0,0,0,0,0,0,61,0,66,0,66,0,66,0,66,0,66,0,66,0,0,0,0,0,0,0,0,0,0,0,  // u
+    9,0,0,0,0,0,0,0,0,8,0,20,0,20,0,34,0,34,0,65,0,65,0,0,0,0,0,0,0,0,0,0,0,  // v
+    9,0,0,0,0,0,0,0,0,34,0,85,0,73,0,73,0,73,0,65,0,65,0,0,0,0,0,0,0,0,0,0,0,  // w
+    9,0,0,0,0,0,0,0,0,65,0,34,0,20,0,8,0,20,0,34,0,65,0,0,0,0,0,0,0,0,0,0,0,  // x
+    9,0,0,60,0,66,0,2,0,58,0,70,0,66,0,66,0,66,0,66,0,66,0,0,0,0,0,0,0,0,0,0,0,  // y
+    9,0,0,0,0,0,0,0,0,127,0,32,0,16,0,8,0,4,0,2,0,127,0,0,0,0,0,0,0,0,0,0,0,  // z
+    9,0,0,0,0,0,0,7,0,8,0,8,0,8,0,4,0,24,0,24,0,4,0,8,0,8,0,8,0,7,0,0,0,  // {
+    9,0,0,0,0,0,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,8,0,0,0,  // |
+    9,0,0,0,0,0,0,112,0,8,0,8,0,8,0,16,0,12,0,12,0,16,0,8,0,8,0,8,0,112,0,0,0,  // }
+    9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,70,0,73,0,49,0,0,0,0,0,  // ~
+};
+static const unsigned short fixed9x15Offsets[] = {
+    0, 33, 66, 99, 132, 165, 198, 231, 264, 297, 330, 363, 396, 429, 462, 495,
+    528, 561, 594, 627, 660, 693, 726, 759, 792, 825, 858, 891, 924, 957, 990, 1023,
+    1056, 1089, 1122, 1155, 1188, 1221, 1254, 1287, 1320, 1353, 1386, 1419, 1452, 1485, 1518, 1551,
+    1584, 1617, 1650, 1683, 1716, 1749, 1782, 1815, 1848, 1881, 1914, 1947, 1980, 2013, 2046, 2079,
+    2112, 2145, 2178, 2211, 2244, 2277, 2310, 2343, 2376, 2409, 2442, 2475, 2508, 2541, 2574, 2607,
+    2640, 2673, 2706, 2739, 2772, 2805, 2838, 2871, 2904, 2937, 2970, 3003, 3036, 3069, 3102,
+};
+
+// -adobe-helvetica-medium-r-normal--18-180-75-75-p-98-iso8859-1
+static const unsigned char helvetica18Bits[] = {
+    5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // space
+    6,0,0,0,0,0,48,48,0,0,32,32,48,48,48,48,48,48,48,48,0,0,0,0,  // !
+    5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,144,144,216,216,216,0,0,0,0,  // "
+    10,0,0,0,0,0,0,0,0,0,0,36,0,36,0,36,0,255,128,255,128,18,0,18,0,18,0,127,192,127,192,9,0,9,0,9,0,0,0,0,0,0,0,0,0,0,0,  // #
+    10,0,0,0,0,0,0,4,0,4,0,31,0,63,128,117,192,100,192,4,192,7,128,31,0,60,0,116,0,100,0,101,128,63,128,31,0,4,0,0,0,0,0,0,0,0,0,  // $
+    16,0,0,0,0,0,0,0,0,0,0,12,60,12,126,6,102,6,102,3,126,3,60,1,128,61,128,126,192,102,192,102,96,126,96,60,48,0,0,0,0,0,0,0,0,0,0,  // %
+    13,0,0,0,0,0,0,0,0,0,0,30,56,63,112,115,224,97,192,97,224,99,96,119,96,62,0,30,0,51,0,51,0,63,0,30,0,0,0,0,0,0,0,0,0,0,0,  // &
+    4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,64,32,32,96,96,0,0,0,0,  // '
+    6,0,8,24,48,48,96,96,96,96,96,96,96,96,96,96,48,48,24,8,0,0,0,0,  // (
+    6,0,64,96,48,48,24,24,24,24,24,24,24,24,24,24,48,48,96,64,0,0,0,0,  // )
+    7,0,0,0,0,0,0,0,0,0,0,0,0,0,68,56,56,124,16,16,0,0,0,0,  // *
+    10,0,0,0,0,0,0,0,0,0,0,12,0,12,0,12,0,12,0,127,128,127,128,12,0,12,0,12,0,12,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // +
+    5,0,0,64,32,32,96,96,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // ,
+    11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,127,128,127,128,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // -
+    5,0,0,0,0,0,96,96,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // .
+    5,0,0,0,0,0,192,192,64,64,96,96,32,32,48,48,16,16,24,24,0,0,0,0,  // /
+    10,0,0,0,0,0,0,0,0,0,0,30,0,63,0,51,0,97,128,97,128,97,128,97,128,97,128,97,128,97,128,51,0,63,0,30,0,0,0,0,0,0,0,0,0,0,0,  // 0
+    10,0,0,0,0,0,0,0,0,0,0,6,0,6,0,6,0,6,0,6,0,6,0,6,0,6,0,6,0,6,0,62,0,62,0,6,0,0,0,0,0,0,0,0,0,0,0,  // 1
+    10,0,0,0,0,0,0,0,0,0,0,127,128,127,128,96,0,112,0,56,0,28,0,14,0,7,0,3,128,1,128,97,128,127,0,30,0,0,0,0,0,0,0,0,0,0,0,  // 2
+    10,0,0,0,0,0,0,0,0,0,0,30,0,63,0,99,128,97,128,1,128,3,128,15,0,14,0,3,0,97,128,97,128,63,0,30,0,0,0,0,0,0,0,0,0,0,0,  // 3
+    10,0,0,0,0,0,0,0,0,0,0,1,128,1,128,1,128,127,192,127,192,97,128,49,128,25,128,25,128,13,128,7,128,3,128,1,128,0,0,0,0,0,0,0,0,0,0,  // 4
+    10,0,0,0,0,0,0,0,0,0,0,62,0,127,0,99,128,97,128,1,128,1,128,99,128,127,0,126,0,96,0,96,0,127,0,127,0,0,0,0,0,0,0,0,0,0,0,  // 5
+    10,0,0,0,0,0,0,0,0,0,0,30,0,63,0,113,128,97,128,97,128,97,128,127,0,110,0,96,0,96,0,49,128,63,128,30,0,0,0,0,0,0,0,0,0,0,0,  // 6
+    10,0,0,0,0,0,0,0,0,0,0,48,0,48,0,24,0,24,0,24,0,12,0,12,0,6,0,6,0,3,0,1,128,127,128,127,128,0,0,0,0,0,0,0,0,0,0,  // 7
+    10,0,0,0,0,0,0,0,0,0,0,30,0,63,0,115,128,97,128,97,128,51,0,63,0,51,0,97,128,97,128,115,128,63,0,30,0,0,0,0,0,0,0,0,0,0,0,  // 8
+    10,0,0,0,0,0,0,0,0,0,0,62,0,127,0,99,0,1,128,1,128,29,128,63,128,97,128,97,128,97,128,99,128,63,0,30,0,0,0,0,0,0,0,0,0,0,0,  // 9
+    5,0,0,0,0,0,96,96,0,0,0,0,0,0,96,96,0,0,0,0,0,0,0,0,  // :
+    5,0,0,64,32,32,96,96,0,0,0,0,0,0,96,96,0,0,0,0,0,0,0,0,  // ;
+    10,0,0,0,0,0,0,0,0,0,0,1,128,7,128,30,0,56,0,96,0,56,0,30,0,7,128,1,128,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // <
+    11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,63,128,63,128,0,0,0,0,63,128,63,128,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // =
+    10,0,0,0,0,0,0,0,0,0,0,96,0,120,0,30,0,7,0,1,128,7,0,30,0,120,0,96,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // >
+    10,0,0,0,0,0,0,0,0,0,0,24,0,24,0,0,0,0,0,24,0,24,0,24,0,28,0,14,0,7,0,99,0,99,0,127,0,62,0,0,0,0,0,0,0,0,0,  // ?
+    18,0,0,0,0,0,0,3,240,0,15,248,0,28,0,0,56,0,0,51,184,0,103,252,0,102,102,0,102,51,0,102,51,0,102,49,128,99,25,128,51,185,128,49,217,128,24,3,0,14,7,0,7,254,0,1,248,0,0,0,0,0,0,0,0,0,0,0,0,0,  // @
+    12,0,0,0,0,0,0,0,0,0,0,192,48,192,48,96,96,96,96,127,224,63,192,48,192,48,192,25,128,25,128,15,0,15,0,6,0,6,0,0,0,0,0,0,0,0,0,  // A
+    13,0,0,0,0,0,0,0,0,0,0,127,192,127,224,96,112,96,48,96,48,96,112,127,224,127,192,96,192,96,96,96,96,96,224,127,192,127,128,0,0,0,0,0,0,0,0,  // B
+    14,0,0,0,0,0,0,0,0,0,0,7,192,31,240,56,56,48,24,112,0,96,0,96,0,96,0,96,0,112,0,48,24,56,56,31,240,7,192,0,0,0,0,0,0,0,0,  // C
+    13,0,0,0,0,0,0,0,0,0,0,127,128,127,192,96,224,96,96,96,48,96,48,96,48,96,48,96,48,96,48,96,96,96,224,127,192,127,128,0,0,0,0,0,0,0,0,  // D
+    11,0,0,0,0,0,0,0,0,0,0,127,192,127,192,96,0,96,0,96,0,96,0,127,128,127,128,96,0,96,0,96,0,96,0,127,192,127,192,0,0,0,0,0,0,0,0,  // E
+    11,0,0,0,0,0,0,0,0,0,0,96,0,96,0,96,0,96,0,96,0,96,0,127,128,127,128,96,0,96,0,96,0,96,0,127,192,127,192,0,0,0,0,0,0,0,0,  // F
+    14,0,0,0,0,0,0,0,0,0,0,7,216,31,248,56,56,48,24,112,24,96,248,96,248,96,0,96,0,112,24,48,24,56,56,31,240,7,192,0,0,0,0,0,0,0,0,  // G
+    13,0,0,0,0,0,0,0,0,0,0,96,48,96,48,96,48,96,48,96,48,96,48,127,240,127,240,96,48,96,48,96,48,96,48,96,48,96,48,0,0,0,0,0,0,0,0,  // H
+    6,0,0,0,0,0,48,48,48,48,48,48,48,48,48,48,48,48,48,48,0,0,0,0,  // I
+    10,0,0,0,0,0,0,0,0,0,0,30,0,63,0,115,128,97,128,97,128,1,128,1,128,1,128,1,128,1,128,1,128,1,128,1,128,1,128,0,0,0,0,0,0,0,0,  // J
+    13,0,0,0,0,0,0,0,0,0,0,96,56,96,112,96,224,97,192,99,128,103,0,126,0,124,0,110,0,103,0,99,128,97,192,96,224,96,112,0,0,0,0,0,0,0,0,  // K
+    10,0,0,0,0,0,0,0,0,0,0,127,128,127,128,96,0,96,0,96,0,96,0,96,0,96,0,96,0,96,0,96,0,96,0,96,0,96,0,0,0,0,0,0,0,0,0,  // L
+    16,0,0,0,0,0,0,0,0,0,0,97,134,97,134,99,198,98,70,102,102,102,102,108,54,108,54,120,30,120,30,112,14,112,14,96,6,96,6,0,0,0,0,0,0,0,0,  // M
+    13,0,0,0,0,0,0,0,0,0,0,96,48,96,112,96,240,96,240,97,176,99,48,99,48,102,48,102,48,108,48,120,48,120,48,112,48,96,48,0,0,0,0,0,0,0,0,  // N
+    15,0,0,0,0,0,0,0,0,0,0,7,192,31,240,56,56,48,24,112,28,96,12,96,12,96,12,96,12,112,28,48,24,56,56,31,240,7,192,0,0,0,0,0,0,0,0,  // O
+    12,0,0,0,0,0,0,0,0,0,0,96,0,96,0,96,0,96,0,96,0,96,0,127,128,127,192,96,224,96,96,96,96,96,224,127,192,127,128,0,0,0,0,0,0,0,0,  // P
+    15,0,0,0,0,0,0,0,0,0,24,7,216,31,240,56,120,48,216,112,220,96,12,96,12,96,12,96,12,112,28,48,24,56,56,31,240,7,192,0,0,0,0,0,0,0,0,  // Q
+    12,0,0,0,0,0,0,0,0,0,0,96,96,96,96,96,96,96,96,96,192,96,192,127,128,127,192,96,224,96,96,96,96,96,224,127,192,127,128,0,0,0,0,0,0,0,0,  // R
+    13,0,0,0,0,0,0,0,0,0,0,31,128,63,224,112,112,96,48,0,48,0,112,1,224,15,128,62,0,112,0,96,48,112,112,63,224,15,128,0,0,0,0,0,0,0,0,  // S
+    12,0,0,0,0,0,0,0,0,0,0,6,0,6,0,6,0,6,0,6,0,6,0,6,0,6,0,6,0,6,0,6,0,6,0,127,224,127,224,0,0,0,0,0,0,0,0,  // T
+    13,0,0,0,0,0,0,0,0,0,0,15,128,63,224,48,96,96,48,96,48,96,48,96,48,96,48,96,48,96,48,96,48,96,48,96,48,96,48,0,0,0,0,0,0,0,0,  // U
+    14,0,0,0,0,0,0,0,0,0,0,3,0,7,128,7,128,12,192,12,192,12,192,24,96,24,96,24,96,48,48,48,48,48,48,96,24,96,24,0,0,0,0,0,0,0,0,  // V
+    18,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,12,12,0,12,12,0,14,28,0,26,22,0,27,54,0,27,54,0,51,51,0,51,51,0,49,35,0,49,227,0,97,225,128,96,193,128,96,193,128,96,193,128,0,0,0,0,0,0,0,0,0,0,0,0,  // W
+    13,0,0,0,0,0,0,0,0,0,0,96,48,112,112,48,96,56,224,24,192,13,128,7,0,7,0,13,128,24,192,56,224,48,96,112,112,96,48,0,0,0,0,0,0,0,0,  // X
+    14,0,0,0,0,0,0,0,0,0,0,3,0,3,0,3,0,3,0,3,0,3,0,7,128,12,192,24,96,24,96,48,48,48,48,96,24,96,24,0,0,0,0,0,0,0,0,  // Y
+    12,0,0,0,0,0,0,0,0,0,0,127,224,127,224,96,0,48,0,24,0,12,0,14,0,6,0,3,0,1,128,0,192,0,96,127,224,127,224,0,0,0,0,0,0,0,0,  // Z
+    5,0,120,120,96,96,96,96,96,96,96,96,96,96,96,96,96,96,120,120,0,0,0,0,  // [
+    5,0,0,0,0,0,24,24,16,16,48,48,32,32,96,96,64,64,192,192,0,0,0,0,  // backslash
+    5,0,240,240,48,48,48,48,48,48,48,48,48,48,48,48,48,48,240,240,0,0,0,0,  // ]
+    9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,65,0,99,0,54,0,28,0,8,0,0,0,0,0,0,0,0,0,0,0,  // ^
+    10,0,0,255,192,255,192,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // _
+    4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,96,96,64,64,32,0,0,0,0,  // `
+    9,0,0,0,0,0,0,0,0,0,0,59,0,119,0,99,0,99,0,115,0,63,0,7,0,99,0,119,0,62,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // a
+    11,0,0,0,0,0,0,0,0,0,0,111,0,127,128,113,128,96,192,96,192,96,192,96,192,113,128,127,128,111,0,96,0,96,0,96,0,96,0,0,0,0,0,0,0,0,0,  // b
+    10,0,0,0,0,0,0,0,0,0,0,31,0,63,128,49,128,96,0,96,0,96,0,96,0,49,128,63,128,31,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // c
+    11,0,0,0,0,0,0,0,0,0,0,30,192,63,192,49,192,96,192,96,192,96,192,96,192,49,192,63,192,30,192,0,192,0,192,0,192,0,192,0,0,0,0,0,0,0,0,  // d
+    10,0,0,0,0,0,0,0,0,0,0,30,0,63,128,113,128,96,0,96,0,127,128,97,128,97,128,63,0,30,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // e
+    6,0,0,0,0,0,48,48,48,48,48,48,48,48,252,252,48,48,60,28,0,0,0,0,  // f
+    11,0,0,14,0,63,128,49,128,0,192,30,192,63,192,49,192,96,192,96,192,96,192,96,192,48,192,63,192,30,192,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // g
+    10,0,0,0,0,0,0,0,0,0,0,97,128,97,128,97,128,97,128,97,128,97,128,97,128,113,128,111,128,103,0,96,0,96,0,96,0,96,0,0,0,0,0,0,0,0,0,  // h
+    4,0,0,0,0,0,96,96,96,96,96,96,96,96,96,96,0,0,96,96,0,0,0,0,  // i
+    4,0,192,224,96,96,96,96,96,96,96,96,96,96,96,96,0,0,96,96,0,0,0,0,  // j
+    9,0,0,0,0,0,0,0,0,0,0,99,128,99,0,103,0,102,0,108,0,124,0,120,0,108,0,102,0,99,0,96,0,96,0,96,0,96,0,0,0,0,0,0,0,0,0,  // k
+    4,0,0,0,0,0,96,96,96,96,96,96,96,96,96,96,96,96,96,96,0,0,0,0,  // l
+    14,0,0,0,0,0,0,0,0,0,0,99,24,99,24,99,24,99,24,99,24,99,24,99,24,115,152,111,120,102,48,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // m
+    10,0,0,0,0,0,0,0,0,0,0,97,128,97,128,97,128,97,128,97,128,97,128,97,128,113,128,111,128,103,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // n
+    11,0,0,0,0,0,0,0,0,0,0,31,0,63,128,49,128,96,192,96,192,96,192,96,192,49,128,63,128,31,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // o
+    11,0,0,96,0,96,0,96,0,96,0,111,0,127,128,113,128,96,192,96,192,96,192,96,192,113,128,127,128,111,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // p
+    11,0,0,0,192,0,192,0,192,0,192,30,192,63,192,49,192,96,192,96,192,96,192,96,192,49,192,63,192,30,192,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // q
+    6,0,0,0,0,0,96,96,96,96,96,96,96,112,108,108,0,0,0,0,0,0,0,0,  // r
+    9,0,0,0,0,0,0,0,0,0,0,60,0,126,0,99,0,3,0,31,0,126,0,96,0,99,0,63,0,30,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // s
+    6,0,0,0,0,0,24,56,48,48,48,48,48,48,252,252,48,48,48,0,0,0,0,0,  // t
+    10,0,0,0,0,0,0,0,0,0,0,57,128,125,128,99,128,97,128,97,128,97,128,97,128,97,128,97,128,97,128,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // u
+    10,0,0,0,0,0,0,0,0,0,0,12,0,12,0,30,0,18,0,51,0,51,0,51,0,97,128,97,128,97,128,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // v
+    14,0,0,0,0,0,0,0,0,0,0,12,192,12,192,28,224,20,160,52,176,51,48,51,48,99,24,99,24,99,24,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // w
+    10,0,0,0,0,0,0,0,0,0,0,97,128,115,128,51,0,30,0,12,0,12,0,30,0,51,0,115,128,97,128,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // x
+    10,0,0,56,0,56,0,12,0,12,0,12,0,12,0,30,0,18,0,51,0,51,0,51,0,97,128,97,128,97,128,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // y
+    9,0,0,0,0,0,0,0,0,0,0,127,0,127,0,96,0,48,0,24,0,12,0,6,0,3,0,127,0,127,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // z
+    6,0,12,24,48,48,48,48,48,48,96,192,96,48,48,48,48,48,24,12,0,0,0,0,  // {
+    4,0,96,96,96,96,96,96,96,96,96,96,96,96,96,96,96,96,96,96,0,0,0,0,  // |
+    6,0,192,96,48,48,48,48,48,48,24,12,24,48,48,48,48,48,96,192,0,0,0,0,  // }
+    10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,102,0,63,0,25,128,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,  // ~
+};
+static const unsigned short helvetica18Offsets[] = {
+    0, 24, 48, 72, 119, 166, 213, 260, 284, 308, 332, 356, 403, 427, 474, 498,
+    522, 569, 616, 663, 710, 757, 804, 851, 898, 945, 992, 1016, 1040, 1087, 1134, 1181,
+    1228, 1298, 1345, 1392, 1439, 1486, 1533, 1580, 1627, 1674, 1698, 1745, 1792, 1839, 1886, 1933,
+    1980, 2027, 2074, 2121, 2168, 2215, 2262, 2309, 2379, 2426, 2473, 2520, 2544, 2568, 2592, 2639,
+    2686, 2710, 2757, 2804, 2851, 2898, 2945, 2969, 3016, 3063, 3087, 3111, 3158, 3182, 3229, 3276,
+    3323, 3370, 3417, 3441, 3488, 3512, 3559, 3606, 3653, 3700, 3747, 3794, 3818, 3842, 3866,
+};
+
+static const BitmapFont FONT_9X15 = { 16, 4, fixed9x15Bits, fixed9x15Offsets };
+static const BitmapFont FONT_HELVETICA_18 = { 23, 5, helvetica18Bits, helvetica18Offsets };
@@ -0,0 +1,53 @@
+#include "input.h"
+#include <algorithm>
+
+void InputState::apply(const InputEvent& ev, GameState state) {
+    switch (ev.type) {
+    case KEY_DOWN:
+        keys[ev.key] = tapped[ev.key] = true;
+        if (ev.key == 13 || ev.key == 10) pending.start = true;
+        if (ev.key == 'r' || ev.key == 'R') pending.restart = true;
+        if (ev.key == ' ') pending.nuke = true;
+        if (ev.key == 'p' || ev.key == 'P') pending.pause = true;
+        if (ev.key == 'e' || ev.key == 'E') pending.dash = true;
+        if (ev.key == 'm' || ev.key == 'M') pending.menu = true;
+        if (ev.key == 'h' || ev.key == 'H') pending.horde = true;
+        break;
+    case KEY_UP:
+        keys[ev.key] = false;
+        break;
+    case BUTTON_DOWN: {
+        mouseHeld = true;
+        int glY = 600 - ev.y;
+        if (state == MENU && ev.x >= 300 && ev.x <= 500 && glY >= 320 && glY <= 360) pending.start = true;
+        if (state == GAME_OVER) {
+            if (ev.x >= 325 && ev.x <= 475 && glY >= 230 && glY <= 260) pending.restart = true;
+            if (ev.x >= 325 && ev.x <= 475 && glY >= 190 && glY <= 220) pending.menu = true;
+        }
+        pending.fire = true;
+        break;
+    }
+    case BUTTON_UP:
+        mouseHeld = false;
+        break;
+    case MOUSE_MOVE:
+        mouseX = ev.x; mouseY = ev.y;
+        break;
+    }
+}
+
+Input InputState::sample() {
+    Input in = pending;
+    pending = Input();
+    auto held = [&](int key) { return keys[key] || tapped[key]; };
+    in.up = held('w') || held(ARROW_UP);
+    in.down = held('s') || held(ARROW_DOWN);
+    in.left = held('a') || held(ARROW_LEFT);
+    in.right = held('d') || held(ARROW_RIGHT);
+    // pending.fire is set by any click since the last tick.
+    in.fire = in.fire || mouseHeld;
+    std::fill(tapped, tapped + 512, false);
+    in.aimX = (float)mouseX;
+    in.aimY = (float)(600 - mouseY);
+    return in;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "game.h"
+
+// Raw window input, forwarded from the GLUT callbacks to the simulation.
+// Special keys use SPECIAL_KEY + their GLUT code; coordinates are window
+// pixels with y pointing down; timeNs is the steady clock when the window
+// system delivered the event.
+enum InputEventType { KEY_DOWN, KEY_UP, BUTTON_DOWN, BUTTON_UP, MOUSE_MOVE };
+
+const int SPECIAL_KEY = 256;
+const int ARROW_LEFT = SPECIAL_KEY + 100, ARROW_UP = SPECIAL_KEY + 101;
+const int ARROW_RIGHT = SPECIAL_KEY + 102, ARROW_DOWN = SPECIAL_KEY + 103;
+
+struct InputEvent { InputEventType type; int key, x, y; long long timeNs; };
+
+// A key or button event and the tick that consumed it, handed back to the
+// render thread to measure input-to-present latency.
+struct InputStamp { long tick; long long timeNs; };
+
+// Held keys and mouse state plus the actions triggered since the last tick.
+// A key or button pressed since the last tick counts as held for the next
+// one even if it was already released, so quick taps are never lost.
+struct InputState {
+    bool keys[512] = { 0 }, tapped[512] = { 0 };
+    int mouseX = 400, mouseY = 300;
+    bool mouseHeld = false;
+    Input pending;
+
+    // state is the game state the event is delivered in; it decides which
+    // menu button a click lands on.
+    void apply(const InputEvent& ev, GameState state);
+    // Input for the next tick; clears the one-shot actions.
+    Input sample();
+};
@@ -0,0 +1,51 @@
+#include "net.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+bool resolveAddress(const char* host, int port, NetAddress& out) {
+    addrinfo hints = {}, *found = nullptr;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    if (getaddrinfo(host, nullptr, &hints, &found) != 0 || !found) return false;
+    out.sa = *(const sockaddr_in*)found->ai_addr;
+    out.sa.sin_port = htons((uint16_t)port);
+    freeaddrinfo(found);
+    return true;
+}
+
+bool UdpSocket::open(int port) {
+    close();
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return false;
+    // Room for a few ticks of snapshots to several clients.
+    int buffer = 1 << 20;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof buffer);
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer, sizeof buffer);
+    sockaddr_in sa = {};
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = htonl(INADDR_ANY);
+    sa.sin_port = htons((uint16_t)port);
+    if (bind(fd, (const sockaddr*)&sa, sizeof sa) != 0 || fcntl(fd, F_SETFL, O_NONBLOCK) != 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void UdpSocket::close() {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+}
+
+bool UdpSocket::send(const NetAddress& to, const uint8_t* data, size_t size) {
+    return sendto(fd, data, size, 0, (const sockaddr*)&to.sa, sizeof to.sa) == (ssize_t)size;
+}
+
+long UdpSocket::receive(uint8_t* buf, size_t capacity, NetAddress& from) {
+    socklen_t len = sizeof from.sa;
+    ssize_t n = recvfrom(fd, buf, capacity, 0, (sockaddr*)&from.sa, &len);
+    return n < 0 ? -1 : (long)n;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <netinet/in.h>
+
+// IPv4 UDP endpoint.
+struct NetAddress {
+    sockaddr_in sa = {};
+    bool operator==(const NetAddress& o) const {
+        return sa.sin_addr.s_addr == o.sa.sin_addr.s_addr && sa.sin_port == o.sa.sin_port;
+    }
+};
+
+bool resolveAddress(const char* host, int port, NetAddress& out);
+
+// Non-blocking UDP socket bound to every interface.
+class UdpSocket {
+public:
+    ~UdpSocket() { close(); }
+    // port 0 picks a free one.
+    bool open(int port);
+    void close();
+    bool send(const NetAddress& to, const uint8_t* data, size_t size);
+    // Copies the next waiting datagram into buf; returns its size, or -1 if
+    // nothing is waiting.
+    long receive(uint8_t* buf, size_t capacity, NetAddress& from);
+
+private:
+    int fd = -1;
+};
+
+// Little-endian packet encoding with LEB128 varints; signed values are
+// zigzagged so small deltas of either sign take one byte.
+struct ByteWriter {
+    std::vector<uint8_t>& out;
+    void u8(uint8_t v) { out.push_back(v); }
+    void i16(int16_t v) { u8((uint8_t)v); u8((uint8_t)((uint16_t)v >> 8)); }
+    void u32(uint32_t v) { for (int i = 0; i < 4; i++) u8((uint8_t)(v >> (8 * i))); }
+    void f32(float v) { uint32_t b; memcpy(&b, &v, 4); u32(b); }
+    void varint(uint64_t v) {
+        while (v >= 0x80) { u8((uint8_t)(v | 0x80)); v >>= 7; }
+        u8((uint8_t)v);
+    }
+    void zigzag(int64_t v) { varint(((uint64_t)v << 1) ^ (uint64_t)(v >> 63)); }
+};
+
+// Reads past the end set ok to false and return zeros.
+struct ByteReader {
+    const uint8_t* data;
+    size_t size, pos = 0;
+    bool ok = true;
+
+    uint8_t u8() {
+        if (pos >= size) { ok = false; return 0; }
+        return data[pos++];
+    }
+    int16_t i16() { uint16_t lo = u8(); return (int16_t)(lo | (uint16_t)u8() << 8); }
+    uint32_t u32() {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++) v |= (uint32_t)u8() << (8 * i);
+        return v;
+    }
+    float f32() { uint32_t b = u32(); float v; memcpy(&v, &b, 4); return v; }
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = u8();
+            v |= (uint64_t)(b & 0x7f) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+    int64_t zigzag() { uint64_t v = varint(); return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+};
@@ -0,0 +1,168 @@
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include "game.h"
+#include "bot.h"
+#include "replay.h"
+#include "render_frame.h"
+#include "renderer.h"
+#include "hud.h"
+
+// Renders a scripted or replayed game into an EGL pbuffer on Mesa's
+// surfaceless platform, so the render path runs without a window system or
+// GPU. Every tick is drawn at alpha 1, which makes the captured frames
+// deterministic for a given seed or replay and renderer build.
+
+const int WIDTH = 800, HEIGHT = 600;
+
+static bool initGL() {
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (!getPlatformDisplay) return false;
+    EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) return false;
+
+    const EGLint configAttribs[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8,
+                                     EGL_BLUE_SIZE, 8, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    EGLConfig config;
+    EGLint configs = 0;
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &configs) || configs < 1) return false;
+    const EGLint surfaceAttribs[] = { EGL_WIDTH, WIDTH, EGL_HEIGHT, HEIGHT, EGL_NONE };
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttribs);
+    if (surface == EGL_NO_SURFACE || !eglBindAPI(EGL_OPENGL_API)) return false;
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, nullptr);
+    if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, surface, surface, context)) return false;
+
+    // The game window's state, with gluOrtho2D spelled out.
+    glViewport(0, 0, WIDTH, HEIGHT);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(0, WIDTH, 0, HEIGHT, -1, 1);
+    glMatrixMode(GL_MODELVIEW);
+    glClearColor(0.05f, 0.05f, 0.1f, 1);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_LINE_SMOOTH);
+    glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+    glEnable(GL_POINT_SMOOTH);
+    return true;
+}
+
+// Binary PPM, top row first.
+static bool writePPM(const char* path, std::vector<unsigned char>& pixels) {
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, WIDTH, HEIGHT, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    fprintf(f, "P6\n%d %d\n255\n", WIDTH, HEIGHT);
+    for (int y = HEIGHT - 1; y >= 0; y--) fwrite(&pixels[(size_t)y * WIDTH * 3], 1, WIDTH * 3, f);
+    return fclose(f) == 0;
+}
+
+int main(int argc, char** argv) {
+    long ticks = 600;
+    uint64_t seed = 1;
+    const char* replayPath = nullptr;
+    const char* outDir = ".";
+    const char* timesPath = nullptr;
+    std::vector<long> captures;
+    long captureEvery = 0;
+    bool horde = false;
+    int tickRate = 60, quality = QUALITY_LEVELS - 1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--ticks") && i + 1 < argc) ticks = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--replay") && i + 1 < argc) replayPath = argv[++i];
+        else if (!strcmp(argv[i], "--capture") && i + 1 < argc) captures.push_back(atol(argv[++i]));
+        else if (!strcmp(argv[i], "--capture-every") && i + 1 < argc) captureEvery = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--out") && i + 1 < argc) outDir = argv[++i];
+        else if (!strcmp(argv[i], "--times") && i + 1 < argc) timesPath = argv[++i];
+        else if (!strcmp(argv[i], "--horde")) horde = true;
+        else if (!strcmp(argv[i], "--tick-rate") && i + 1 < argc) tickRate = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--quality") && i + 1 < argc) quality = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--ticks N] [--seed S] [--replay FILE] [--horde] [--tick-rate HZ] [--quality 0-%d]\n"
+                            "       [--capture TICK]... [--capture-every N] [--out DIR] [--times FILE]\n", argv[0], QUALITY_LEVELS - 1);
+            return 1;
+        }
+    }
+
+    ReplayPlayer replay;
+    if (tickRate <= 0) { fprintf(stderr, "--tick-rate must be positive\n"); return 1; }
+    float dt = 1.0f / tickRate;
+    if (replayPath) {
+        if (!replay.open(replayPath)) { fprintf(stderr, "cannot read replay %s\n", replayPath); return 1; }
+        seed = replay.seed;
+        dt = replay.dt;
+        ticks = 0;
+    }
+    if (!initGL()) { fprintf(stderr, "cannot create a surfaceless EGL context (error 0x%x)\n", eglGetError()); return 1; }
+    printf("renderer %s\n", (const char*)glGetString(GL_RENDERER));
+    setRenderQuality(qualityLevel(std::max(0, std::min(QUALITY_LEVELS - 1, quality))));
+
+    World world;
+    seedWorld(world, seed);
+    if (horde) world.config.horde.startHealth = 1 << 30;
+    RenderFrame frame;
+    Hud hud;
+    std::vector<float> renderMs;
+    std::vector<unsigned char> pixels((size_t)WIDTH * HEIGHT * 3);
+    int written = 0;
+    for (long t = 0; replayPath || t < ticks; t++) {
+        Input in;
+        if (!replayPath) in = autopilot(world, t, horde);
+        else if (!replay.next(in)) break;
+        else ticks++;
+        step(world, in, dt);
+        captureFrame(world, t, frame);
+
+        // Timed up to glFinish(), like the game's governor, so this is the
+        // real render cost and not just command submission.
+        auto start = std::chrono::steady_clock::now();
+        glClear(GL_COLOR_BUFFER_BIT);
+        glPushMatrix();
+        glTranslatef(frame.screenShakeX, frame.screenShakeY, 0);
+        drawGrid();
+        drawScene(frame);
+        flushBatches();
+        glPopMatrix();
+        hud.begin();
+        gameHud(hud, frame);
+        hud.end();
+        glFinish();
+        renderMs.push_back(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+        bool capture = (captureEvery > 0 && t % captureEvery == 0) || std::count(captures.begin(), captures.end(), t);
+        if (capture) {
+            char path[512];
+            snprintf(path, sizeof path, "%s/frame_%06ld.ppm", outDir, t);
+            if (!writePPM(path, pixels)) { fprintf(stderr, "cannot write %s\n", path); return 1; }
+            written++;
+        }
+    }
+    if (renderMs.empty()) { fprintf(stderr, "no frames rendered\n"); return 1; }
+
+    double total = 0;
+    for (float ms : renderMs) total += ms;
+    std::vector<float> sorted = renderMs;
+    std::sort(sorted.begin(), sorted.end());
+    auto pct = [&](float q) { return sorted[std::min(sorted.size() - 1, (size_t)(q * sorted.size()))]; };
+    printf("frames %zu  render ms mean %.3f  p50 %.3f  p99 %.3f  max %.3f\n", renderMs.size(), total / renderMs.size(),
+           pct(0.5f), pct(0.99f), sorted.back());
+    if (timesPath) {
+        FILE* f = fopen(timesPath, "w");
+        if (!f) { fprintf(stderr, "cannot write %s\n", timesPath); return 1; }
+        fprintf(f, "tick,render_ms\n");
+        for (size_t t = 0; t < renderMs.size(); t++) fprintf(f, "%zu,%.4f\n", t, renderMs[t]);
+        fclose(f);
+    }
+    printf("hud rebuilds %d\n", hud.rebuilds);
+    printf("captured %d frames to %s\n", written, outDir);
+    printf("seed %llu  world hash %016llx\n", (unsigned long long)seed, (unsigned long long)hashWorld(world));
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include "particles.h"
+#if defined(__AVX__) || defined(__SSE__)
+#include <immintrin.h>
+#endif
+
+void ParticleSystem::reserve(int capacity) {
+    // Round up to the vector width so the kernel never needs a scalar tail.
+    int padded = (capacity + 7) & ~7;
+    x.resize(padded); y.resize(padded);
+    vx.resize(padded); vy.resize(padded);
+    r.resize(padded);
+    if (count > padded) count = padded;
+}
+
+static void integrate(float* x, float* y, float* vx, float* vy, float* r, int n, float k, float drag, float shrink) {
+    int i = 0;
+#if defined(__AVX__)
+    __m256 k8 = _mm256_set1_ps(k), drag8 = _mm256_set1_ps(drag), shrink8 = _mm256_set1_ps(shrink);
+    for (; i < n; i += 8) {
+        __m256 px = _mm256_loadu_ps(x + i), py = _mm256_loadu_ps(y + i);
+        __m256 pvx = _mm256_loadu_ps(vx + i), pvy = _mm256_loadu_ps(vy + i);
+        _mm256_storeu_ps(x + i, _mm256_add_ps(px, _mm256_mul_ps(pvx, k8)));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(py, _mm256_mul_ps(pvy, k8)));
+        _mm256_storeu_ps(vx + i, _mm256_mul_ps(pvx, drag8));
+        _mm256_storeu_ps(vy + i, _mm256_mul_ps(pvy, drag8));
+        _mm256_storeu_ps(r + i, _mm256_mul_ps(_mm256_loadu_ps(r + i), shrink8));
+    }
+#elif defined(__SSE__)
+    __m128 k4 = _mm_set1_ps(k), drag4 = _mm_set1_ps(drag), shrink4 = _mm_set1_ps(shrink);
+    for (; i < n; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i), py = _mm_loadu_ps(y + i);
+        __m128 pvx = _mm_loadu_ps(vx + i), pvy = _mm_loadu_ps(vy + i);
+        _mm_storeu_ps(x + i, _mm_add_ps(px, _mm_mul_ps(pvx, k4)));
+        _mm_storeu_ps(y + i, _mm_add_ps(py, _mm_mul_ps(pvy, k4)));
+        _mm_storeu_ps(vx + i, _mm_mul_ps(pvx, drag4));
+        _mm_storeu_ps(vy + i, _mm_mul_ps(pvy, drag4));
+        _mm_storeu_ps(r + i, _mm_mul_ps(_mm_loadu_ps(r + i), shrink4));
+    }
+#endif
+    for (; i < n; i++) {
+        x[i] += vx[i] * k;
+        y[i] += vy[i] * k;
+        vx[i] *= drag;
+        vy[i] *= drag;
+        r[i] *= shrink;
+    }
+}
+
+void ParticleSystem::update(float k, float drag, float shrink, float minRadius) {
+    // Lanes past count are padding and may hold stale values; they are
+    // overwritten by the next emit so processing them is harmless.
+    integrate(x.data(), y.data(), vx.data(), vy.data(), r.data(), count, k, drag, shrink);
+    for (int i = 0; i < count;) {
+        if (r[i] >= minRadius) { i++; continue; }
+        count--;
+        x[i] = x[count]; y[i] = y[count];
+        vx[i] = vx[count]; vy[i] = vy[count];
+        r[i] = r[count];
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <vector>
+#include "vec2.h"
+
+// Structure-of-arrays particle store with a fixed capacity. Emits past the
+// capacity are dropped; dead particles are removed by swapping in the last one.
+struct ParticleSystem {
+    std::vector<float> x, y, vx, vy, r;
+    int count = 0;
+
+    explicit ParticleSystem(int capacity = 0) { reserve(capacity); }
+
+    void reserve(int capacity);
+    int capacity() const { return (int)r.size(); }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() { count = 0; }
+
+    void emit(Vec2 pos, Vec2 vel, float radius) {
+        if (count >= capacity()) return;
+        x[count] = pos.x; y[count] = pos.y;
+        vx[count] = vel.x; vy[count] = vel.y;
+        r[count] = radius;
+        count++;
+    }
+
+    // Moves every particle k ticks, damps velocity by drag, scales radius by
+    // shrink and removes those that shrank below minRadius.
+    void update(float k, float drag, float shrink, float minRadius);
+};
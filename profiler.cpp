@@ -0,0 +1,57 @@
+#include "profiler.h"
+#include <algorithm>
+#include <cstdio>
+
+float RollingTimes::percentile(float q) const {
+    if (!count) return 0;
+    float sorted[N];
+    std::copy(samples, samples + count, sorted);
+    int k = std::min(count - 1, (int)(q * count));
+    std::nth_element(sorted, sorted + k, sorted + count);
+    return sorted[k];
+}
+
+float LatencyHistogram::percentile(float q) const {
+    long seen = 0, want = (long)(q * total);
+    for (int b = 0; b < BUCKETS; b++) {
+        seen += counts[b];
+        if (seen > want) return b + 1.0f;
+    }
+    return (float)BUCKETS;
+}
+
+bool LatencyHistogram::writeJson(const char* path) const {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f, "{\n  \"events\": %ld,\n  \"p50_ms\": %.0f,\n  \"p90_ms\": %.0f,\n  \"p99_ms\": %.0f,\n  \"max_ms\": %.2f,\n",
+            total, percentile(0.5f), percentile(0.9f), percentile(0.99f), maxMs);
+    fprintf(f, "  \"bucket_ms\": 1,\n  \"counts\": [");
+    for (int b = 0; b < BUCKETS; b++) fprintf(f, "%s%ld", b ? ", " : "", counts[b]);
+    fprintf(f, "]\n}\n");
+    return fclose(f) == 0;
+}
+
+bool writeChromeTrace(const char* path, const Profiler* const* profilers, int count) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    // Enclosing scopes such as PH_TICK are pushed after their children, so
+    // the earliest start can be anywhere in a trace.
+    long long origin = -1;
+    for (int t = 0; t < count; t++)
+        for (const TraceEvent& e : profilers[t]->trace)
+            if (origin < 0 || e.startNs < origin) origin = e.startNs;
+
+    fprintf(f, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    bool first = true;
+    for (int t = 0; t < count; t++) {
+        const Profiler& p = *profilers[t];
+        fprintf(f, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"%s\"}}",
+                first ? "" : ",\n", t + 1, p.threadName);
+        first = false;
+        for (const TraceEvent& e : p.trace)
+            fprintf(f, ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                    phaseName(e.phase), t + 1, (e.startNs - origin) / 1000.0, e.durNs / 1000.0);
+    }
+    fprintf(f, "\n]}\n");
+    return fclose(f) == 0;
+}
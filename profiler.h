@@ -0,0 +1,138 @@
+#pragma once
+#include <chrono>
+#include <vector>
+
+// Phases of a tick and of a frame. Timing is opt-in: everything below is a
+// no-op while the Profiler pointer is null, which is the default.
+enum ProfilePhase {
+    PH_PLAYER, PH_BULLETS, PH_SPAWN, PH_ENEMIES, PH_PICKUPS, PH_COLLISION,
+    PH_COMPACT, PH_TRAILS, PH_EVENTS, PH_PARTICLES,
+    PH_SCENE, PH_FLUSH, PH_HUD, PH_SWAP,
+    PH_TICK, PH_FRAME,
+    PHASE_COUNT
+};
+
+// step() phases are [0, SIM_PHASES_END), display() phases [SIM_PHASES_END, RENDER_PHASES_END).
+const int SIM_PHASES_END = PH_SCENE;
+const int RENDER_PHASES_END = PH_TICK;
+
+inline const char* phaseName(int p) {
+    static const char* const names[PHASE_COUNT] = {
+        "player", "bullets", "spawn", "enemies", "pickups", "collision",
+        "compact", "trails", "events", "particles",
+        "scene", "flush", "hud", "swap",
+        "tick", "frame",
+    };
+    return names[p];
+}
+
+struct TraceEvent { int phase; long long startNs, durNs; };
+
+// Nanoseconds and call counts per phase since the last clear(), plus an
+// optional timeline for trace export. Not thread-safe; give each thread its
+// own.
+struct Profiler {
+    using clock = std::chrono::steady_clock;
+    const char* threadName = "main";
+    long long ns[PHASE_COUNT] = {};
+    long long calls[PHASE_COUNT] = {};
+    // Filled while tracing until the reserved capacity runs out, so recording
+    // never allocates.
+    std::vector<TraceEvent> trace;
+    bool tracing = false;
+
+    void add(ProfilePhase p, clock::time_point start, clock::time_point end) {
+        long long d = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        ns[p] += d;
+        calls[p]++;
+        if (tracing && trace.size() < trace.capacity())
+            trace.push_back({ p, std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count(), d });
+    }
+    void clear() {
+        for (int p = 0; p < PHASE_COUNT; p++) ns[p] = calls[p] = 0;
+    }
+    void startTrace(size_t maxEvents) {
+        trace.clear();
+        trace.reserve(maxEvents);
+        tracing = true;
+    }
+    bool traceFull() const { return tracing && trace.size() == trace.capacity(); }
+};
+
+// Writes the timelines of several profilers (one per thread) as Chrome
+// trace-event JSON, viewable in chrome://tracing or Perfetto.
+bool writeChromeTrace(const char* path, const Profiler* const* profilers, int count);
+
+// Times a block.
+struct ScopedPhase {
+    Profiler* prof;
+    ProfilePhase phase;
+    Profiler::clock::time_point start;
+
+    ScopedPhase(Profiler* prof, ProfilePhase phase) : prof(prof), phase(phase) {
+        if (prof) start = Profiler::clock::now();
+    }
+    ~ScopedPhase() { if (prof) prof->add(phase, start, Profiler::clock::now()); }
+};
+
+// Times consecutive stretches of one function: lap(p) charges everything
+// since the previous lap (or construction) to p.
+struct PhaseLaps {
+    Profiler* prof;
+    Profiler::clock::time_point last;
+
+    explicit PhaseLaps(Profiler* prof) : prof(prof) { if (prof) last = Profiler::clock::now(); }
+    void lap(ProfilePhase p) {
+        if (!prof) return;
+        auto now = Profiler::clock::now();
+        prof->add(p, last, now);
+        last = now;
+    }
+};
+
+// Counts ticks whose work took longer than the frame budget.
+struct FrameBudget {
+    float budgetMs = 16;
+    long overruns = 0;
+    float worstMs = 0;
+
+    bool check(float ms) {
+        worstMs = ms > worstMs ? ms : worstMs;
+        if (ms <= budgetMs) return false;
+        overruns++;
+        return true;
+    }
+};
+
+// Input-to-present latency in 1 ms buckets; the last bucket collects
+// everything from 100 ms up.
+struct LatencyHistogram {
+    static const int BUCKETS = 101;
+    long counts[BUCKETS] = {};
+    long total = 0;
+    float maxMs = 0;
+
+    void add(float ms) {
+        int b = ms < 0 ? 0 : ms >= BUCKETS - 1 ? BUCKETS - 1 : (int)ms;
+        counts[b]++;
+        total++;
+        maxMs = ms > maxMs ? ms : maxMs;
+    }
+    // Upper edge of the bucket holding the q-quantile, in ms.
+    float percentile(float q) const;
+    bool writeJson(const char* path) const;
+};
+
+// The last N frame or tick times, for rolling percentiles.
+struct RollingTimes {
+    static const int N = 256;
+    float samples[N] = {};
+    int count = 0, next = 0;
+
+    void add(float ms) {
+        samples[next] = ms;
+        next = (next + 1) % N;
+        if (count < N) count++;
+    }
+    float percentile(float q) const;
+};
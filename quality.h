@@ -0,0 +1,45 @@
+#pragma once
+
+// Render detail levels, from 0 (cheapest) to QUALITY_LEVELS - 1 (full). The
+// expensive parts of a frame under software GL are the glow fans around every
+// object, circle tessellation, trail strips and particle points.
+struct RenderQuality {
+    int glowPasses;      // filled halos per glowing object
+    int circleSegments;  // 8, 12, 20 or 30
+    int trailStride;     // draw one trail point in this many
+    int maxParticles;    // drawn particles; the rest are skipped evenly
+};
+
+const int QUALITY_LEVELS = 4;
+
+inline RenderQuality qualityLevel(int level) {
+    static const RenderQuality levels[QUALITY_LEVELS] = {
+        { 0, 8, 4, 2048 },
+        { 1, 12, 3, 8192 },
+        { 2, 20, 2, 32768 },
+        { 3, 30, 1, 1 << 30 },
+    };
+    return levels[level < 0 ? 0 : level >= QUALITY_LEVELS ? QUALITY_LEVELS - 1 : level];
+}
+
+// Picks a level from measured frame render times: steps down quickly when a
+// smoothed frame nears the budget and back up slowly once there is plenty of
+// headroom. A pinned governor never changes level.
+struct QualityGovernor {
+    int level = QUALITY_LEVELS - 1;
+    bool pinned = false;
+    float budgetMs = 16, averageMs = 0;
+    int framesAtLevel = 0;
+
+    // Feeds one frame's render time; returns true if the level changed.
+    bool update(float ms) {
+        averageMs = averageMs > 0 ? averageMs * 0.9f + ms * 0.1f : ms;
+        framesAtLevel++;
+        if (pinned || framesAtLevel < 30) return false;
+        if (averageMs > budgetMs * 0.85f && level > 0) level--;
+        else if (averageMs < budgetMs * 0.4f && level < QUALITY_LEVELS - 1 && framesAtLevel >= 120) level++;
+        else return false;
+        framesAtLevel = 0;
+        return true;
+    }
+};
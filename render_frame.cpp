@@ -0,0 +1,30 @@
+#include "render_frame.h"
+
+void captureFrame(const World& w, long tick, RenderFrame& f) {
+    f.tick = tick;
+    f.gameState = w.gameState;
+    f.mode = w.mode;
+    f.score = w.score; f.highScore = w.highScore; f.ammo = w.ammo; f.nukes = w.nukes;
+    f.playerHealth = w.playerHealth; f.maxHealth = w.maxHealth;
+    f.wave = w.wave; f.comboCount = w.comboCount; f.enemiesLeftInWave = w.enemiesLeftInWave;
+    f.waveAmmo = waveAmmo(w); f.waveNukes = waveNukes(w.wave);
+    f.survivalTime = w.survivalTime; f.dashCooldown = w.dashCooldown;
+    f.rapidFireTimer = w.rapidFireTimer; f.slowMoTimer = w.slowMoTimer;
+    f.screenShakeX = w.screenShakeX; f.screenShakeY = w.screenShakeY;
+    f.hasShield = w.hasShield;
+
+    f.player = w.player;
+    f.playerPrev = w.playerPrev;
+    f.playerTrail = w.playerTrail;
+    f.trailTimer = w.trailTimer;
+    for (int i = 0; i < MAX_PLAYERS - 1; i++) f.allies[i] = w.allies[i];
+    f.bullets = w.bullets;
+    f.enemies = w.enemies;
+    f.ammoBoxes = w.ammoBoxes;
+    f.powerUps = w.powerUps;
+
+    const ParticleSystem& ps = w.particles;
+    f.particleX.assign(ps.x.begin(), ps.x.begin() + ps.size());
+    f.particleY.assign(ps.y.begin(), ps.y.begin() + ps.size());
+    f.particleR.assign(ps.r.begin(), ps.r.begin() + ps.size());
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <vector>
+#include "game.h"
+
+// Immutable copy of everything display() needs, published by the simulation
+// once per tick. The renderer only ever reads frames, never the live World.
+struct RenderFrame {
+    long tick = 0;
+    GameState gameState = MENU;
+    GameMode mode = CLASSIC;
+    int score = 0, highScore = 0, ammo = 0, nukes = 0, playerHealth = 0, maxHealth = 0;
+    int wave = 0, comboCount = 0, enemiesLeftInWave = 0;
+    int waveAmmo = 0, waveNukes = 0;  // granted on reaching this wave
+    float survivalTime = 0, dashCooldown = 0, rapidFireTimer = 0, slowMoTimer = 0;
+    float screenShakeX = 0, screenShakeY = 0;
+    bool hasShield = false;
+
+    Ship player = {};
+    Vec2 playerPrev = {};
+    ShipTrail playerTrail;
+    float trailTimer = 0;
+    Ally allies[MAX_PLAYERS - 1] = {};
+    Bullets bullets;
+    Enemies enemies;
+    AmmoBoxes ammoBoxes;
+    PowerUps powerUps;
+    std::vector<float> particleX, particleY, particleR;
+
+    // Set by SimThread while profiling: this tick's phase times and the
+    // rolling tick-time percentiles.
+    bool profiled = false;
+    float phaseMs[SIM_PHASES_END] = {};
+    float tickMs = 0, tickP50 = 0, tickP99 = 0;
+    // When this tick fell due on the steady clock, for interpolating towards
+    // the next one, and how late ticks start (p50/p99 over recent ticks).
+    long long tickDueNs = 0;
+    float tickSeconds = TICK;
+    float jitterP50 = 0, jitterP99 = 0;
+    long droppedTicks = 0;
+    // Ticks so far whose step() overran the frame budget, and the slowest tick.
+    long overruns = 0;
+    float worstTickMs = 0;
+    // Rewind history: cost of the last and slowest capture, snapshots held.
+    float snapshotUs = 0, snapshotWorstUs = 0;
+    long rewindSnapshots = 0, rewindBytes = 0;
+};
+
+// Copies w into f, reusing f's buffers so steady-state captures do not allocate.
+void captureFrame(const World& w, long tick, RenderFrame& f);
@@ -0,0 +1,299 @@
+#include "renderer.h"
+#include <GL/gl.h>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+RenderStats renderStats;
+static RenderQuality quality = qualityLevel(QUALITY_LEVELS - 1);
+
+void setRenderQuality(const RenderQuality& q) { quality = q; }
+
+struct Vertex { float x, y; unsigned char rgba[4]; };
+
+struct Batch { std::vector<Vertex> verts; };
+
+// Points are bucketed by whole-pixel size so each size is one draw call.
+const int MAX_POINT_SIZE = 12;
+static Batch tris, lines, thickLines;
+static Batch points[MAX_POINT_SIZE + 1];
+
+// Unit shapes, built once on first use.
+struct UnitShapes {
+    Vec2 circle30[30], circle20[20], circle12[12], circle8[8], star[10], heart[100];
+    UnitShapes() {
+        makeCircle(circle30, 30); makeCircle(circle20, 20); makeCircle(circle12, 12); makeCircle(circle8, 8);
+        for (int i = 0; i < 10; i++) {
+            float angle = i * 3.14159f / 5;
+            float r = (i % 2 == 0) ? 1 : 0.4f;
+            star[i] = { cosf(angle) * r, sinf(angle) * r };
+        }
+        for (int i = 0; i < 100; i++) {
+            float t = i * 3.14159f * 2 / 100;
+            float hx = 16 * powf(sinf(t), 3);
+            float hy = 13 * cosf(t) - 5 * cosf(2 * t) - 2 * cosf(3 * t) - cosf(4 * t);
+            heart[i] = { hx * 0.05f, -hy * 0.05f };
+        }
+    }
+    static void makeCircle(Vec2* out, int n) {
+        for (int i = 0; i < n; i++) out[i] = { cosf(i * 3.14159f * 2 / n), sinf(i * 3.14159f * 2 / n) };
+    }
+    const Vec2* circle(int segments) const {
+        return segments >= 30 ? circle30 : segments >= 20 ? circle20 : segments >= 12 ? circle12 : circle8;
+    }
+};
+
+static const UnitShapes& shapes() {
+    static UnitShapes s;
+    return s;
+}
+
+// Circle segment count actually available for the current quality.
+static int circleSegments(int wanted) {
+    int n = std::min(wanted, quality.circleSegments);
+    return n >= 30 ? 30 : n >= 20 ? 20 : n >= 12 ? 12 : 8;
+}
+
+static unsigned char channel(float c) { return (unsigned char)(std::max(0.0f, std::min(1.0f, c)) * 255 + 0.5f); }
+
+struct Color {
+    unsigned char c[4];
+    Color(float R, float G, float B, float A = 1) : c{ channel(R), channel(G), channel(B), channel(A) } {}
+};
+
+static void put(Batch& b, float x, float y, const Color& col) {
+    b.verts.push_back({ x, y, { col.c[0], col.c[1], col.c[2], col.c[3] } });
+}
+
+// Closed outline through n points: (p[i], p[i+1]) segments for GL_LINES.
+static void outline(const Vec2* unit, int n, float x, float y, float sx, float sy, float rot, const Color& col) {
+    float c = cosf(rot), s = sinf(rot);
+    for (int i = 0; i < n; i++) {
+        Vec2 a = unit[i], b = unit[(i + 1) % n];
+        put(lines, x + (a.x * c - a.y * s) * sx, y + (a.x * s + a.y * c) * sy, col);
+        put(lines, x + (b.x * c - b.y * s) * sx, y + (b.x * s + b.y * c) * sy, col);
+    }
+}
+
+// Filled fan around (x, y) for a shape that is star-shaped about its origin.
+static void fill(const Vec2* unit, int n, float x, float y, float scale, const Color& col) {
+    for (int i = 0; i < n; i++) {
+        Vec2 a = unit[i], b = unit[(i + 1) % n];
+        put(tris, x, y, col);
+        put(tris, x + a.x * scale, y + a.y * scale, col);
+        put(tris, x + b.x * scale, y + b.y * scale, col);
+    }
+}
+
+void drawCircle(float x, float y, float r, float R, float G, float B, bool filled) {
+    int n = circleSegments(30);
+    if (filled) fill(shapes().circle(n), n, x, y, r, Color(R, G, B));
+    else outline(shapes().circle(n), n, x, y, r, r, 0, Color(R, G, B));
+}
+
+void drawGlow(float x, float y, float r, float R, float G, float B, float alpha) {
+    int n = circleSegments(30);
+    for (int i = 0; i < std::min(3, quality.glowPasses); i++)
+        fill(shapes().circle(n), n, x, y, r + i * 3, Color(R, G, B, alpha - i * 0.1f));
+}
+
+void drawSquare(float x, float y, float size, float rotation, float R, float G, float B) {
+    static const Vec2 unit[4] = { {-1, -1}, {1, -1}, {1, 1}, {-1, 1} };
+    outline(unit, 4, x, y, size, size, rotation * 3.14159f / 180, Color(R, G, B));
+}
+
+void drawStar(float x, float y, float size, float rotation, float R, float G, float B) {
+    outline(shapes().star, 10, x, y, size, size, rotation * 3.14159f / 180, Color(R, G, B));
+}
+
+void drawHeart(float x, float y, float size, bool filled) {
+    if (filled) fill(shapes().heart, 100, x, y, size, Color(1, 0, 0));
+    else outline(shapes().heart, 100, x, y, size, size, 0, Color(1, 0, 0));
+}
+
+void drawRect(float x, float y, float w, float h, float R, float G, float B) {
+    static const Vec2 unit[4] = { {0, 0}, {1, 0}, {1, 1}, {0, 1} };
+    outline(unit, 4, x, y, w, h, 0, Color(R, G, B));
+}
+
+void drawLine(float x0, float y0, float x1, float y1, float R, float G, float B, bool thick) {
+    Batch& b = thick ? thickLines : lines;
+    Color col(R, G, B);
+    put(b, x0, y0, col);
+    put(b, x1, y1, col);
+}
+
+void drawPoint(float x, float y, float size, float R, float G, float B) {
+    int bucket = std::max(1, std::min(MAX_POINT_SIZE, (int)(size + 0.5f)));
+    put(points[bucket], x, y, Color(R, G, B));
+}
+
+void drawGrid() {
+    static GLuint list = 0;
+    if (list) { glCallList(list); return; }
+    list = glGenLists(1);
+    glNewList(list, GL_COMPILE_AND_EXECUTE);
+    glColor4ub(channel(0.1f), channel(0.1f), channel(0.15f), 255);
+    glBegin(GL_LINES);
+    for (int i = 0; i < 800; i += 40) { glVertex2f(i, 0); glVertex2f(i, 600); }
+    for (int i = 0; i < 600; i += 40) { glVertex2f(0, i); glVertex2f(800, i); }
+    glEnd();
+    glEndList();
+}
+
+// One triangle strip from head back through every trailStride-th point of
+// the trail from newest to its oldest, narrowing from halfWidth and fading
+// from alpha to nothing along the way.
+template <int N>
+static void drawTrail(Vec2 head, const TrailRing<N>& trail, int newest, float halfWidth, float alpha) {
+    if (trail.count <= newest) return;
+    Vec2 p[N + 1];
+    int n = 0;
+    p[n++] = head;
+    for (int i = newest; i < trail.count; i += quality.trailStride) p[n++] = trail.at(i);
+    if ((trail.count - 1 - newest) % quality.trailStride) p[n++] = trail.at(trail.count - 1);
+    Vec2 left = {}, right = {};
+    Color last(0, 0, 0);
+    for (int i = 0; i < n; i++) {
+        Vec2 d = p[std::min(i + 1, n - 1)] - p[std::max(i - 1, 0)];
+        float taper = 1 - (float)i / (n - 1);
+        Vec2 side = normalize(Vec2{ -d.y, d.x }) * (halfWidth * taper);
+        Vec2 l = p[i] + side, r = p[i] - side;
+        Color c(0, 0.8f, 1, alpha * taper);
+        if (i > 0) {
+            put(tris, left.x, left.y, last); put(tris, right.x, right.y, last); put(tris, l.x, l.y, c);
+            put(tris, right.x, right.y, last); put(tris, r.x, r.y, c); put(tris, l.x, l.y, c);
+        }
+        left = l; right = r; last = c;
+    }
+}
+
+void drawScene(const RenderFrame& w, float alpha) {
+    if (w.gameState == MENU) return;
+
+    // Bullets and enemies moved exactly vel * k this tick, so their previous
+    // position is pos - vel * k. Ships are clamped to the arena, so the frame
+    // carries their real previous positions.
+    bool moving = w.gameState == PLAYING && alpha < 1;
+    float back = moving ? (1 - alpha) * w.tickSeconds / TICK : 0;
+    auto shipAt = [&](const Ship& s, Vec2 prev) { return moving ? prev + (s.pos - prev) * alpha : s.pos; };
+
+    // Trail points taken later in the tick than the interpolated position
+    // would fold the strip forward; every trail takes points together, so
+    // one count skips them all.
+    float lag = moving ? (1 - alpha) * w.tickSeconds : 0;
+    int newest = 0;
+    while (w.trailTimer + newest * TICK <= lag) newest++;
+    drawTrail(shipAt(w.player, w.playerPrev), w.playerTrail, newest, 6, 0.5f);
+    for (const Ally& a : w.allies)
+        if (a.joined) drawTrail(shipAt(a.ship, a.prev), a.trail, newest, 6, 0.5f);
+    const Bullets& bullets = w.bullets;
+    for (size_t i = 0; i < bullets.size(); i++) drawTrail(bullets.pos[i] - bullets.vel[i] * back, bullets.trail[i], newest, 3, 0.3f);
+
+    const AmmoBoxes& boxes = w.ammoBoxes;
+    for (size_t i = 0; i < boxes.size(); i++) {
+        Vec2 b = boxes.pos[i];
+        float rotation = boxes.rotation[i];
+        drawGlow(b.x, b.y, AMMO_RADIUS, 0, 1, 0);
+        drawSquare(b.x, b.y, AMMO_RADIUS, rotation, 0, 1, 0);
+        drawSquare(b.x, b.y, AMMO_RADIUS * 0.6f, -rotation, 0.5f, 1, 0.5f);
+    }
+
+    const PowerUps& powerUps = w.powerUps;
+    for (size_t i = 0; i < powerUps.size(); i++) {
+        Vec2 p = powerUps.pos[i];
+        float r = POWERUP_RADIUS, rotation = powerUps.rotation[i];
+        float pulseSize = r + sin(powerUps.pulse[i]) * 3;
+        int type = powerUps.type[i];
+        if (type == 0) {
+            drawGlow(p.x, p.y, pulseSize, 1, 0, 1);
+            drawStar(p.x, p.y, r, rotation, 1, 0, 1);
+        }
+        else if (type == 1) {
+            drawGlow(p.x, p.y, pulseSize, 0, 0.5f, 1);
+            drawCircle(p.x, p.y, r, 0, 0.5f, 1);
+        }
+        else if (type == 2) {
+            drawGlow(p.x, p.y, pulseSize, 1, 0.5f, 0);
+            drawSquare(p.x, p.y, r, rotation, 1, 0.5f, 0);
+        }
+        else {
+            drawGlow(p.x, p.y, pulseSize, 0, 1, 1);
+            drawCircle(p.x, p.y, r, 0, 1, 1);
+            drawCircle(p.x, p.y, r * 0.5f, 0.5f, 1, 1);
+        }
+    }
+
+    const Ship& player = w.player;
+    if (player.alive) {
+        Vec2 p = shipAt(player, w.playerPrev);
+        drawGlow(p.x, p.y, player.radius, 0, 0.8f, 1);
+        drawCircle(p.x, p.y, player.radius, 0, 1, 1);
+        drawCircle(p.x, p.y, player.radius * 0.6f, 0.5f, 1, 1);
+        if (w.hasShield) drawCircle(p.x, p.y, player.radius + 5, 0, 0.5f, 1);
+    }
+    for (const Ally& a : w.allies) {
+        if (!a.joined || !a.ship.alive) continue;
+        Vec2 p = shipAt(a.ship, a.prev);
+        drawGlow(p.x, p.y, a.ship.radius, 0.3f, 1, 0.3f);
+        drawCircle(p.x, p.y, a.ship.radius, 0.3f, 1, 0.3f);
+        drawCircle(p.x, p.y, a.ship.radius * 0.6f, 0.7f, 1, 0.7f);
+    }
+
+    for (size_t i = 0; i < bullets.size(); i++) {
+        Vec2 p = bullets.pos[i] - bullets.vel[i] * back;
+        drawGlow(p.x, p.y, BULLET_RADIUS, 1, 1, 0);
+        drawCircle(p.x, p.y, BULLET_RADIUS, 1, 1, 0, true);
+    }
+
+    const Enemies& enemies = w.enemies;
+    forEachEnemyType([&](auto type) {
+        constexpr EnemyTraits t = ENEMY_TRAITS[decltype(type)::value];
+        for (size_t i = enemies.begin(type), end = enemies.end(type); i < end; i++) {
+            Vec2 p = enemies.pos[i] - enemies.vel[i] * back;
+            drawGlow(p.x, p.y, t.radius, t.r, t.g, t.b);
+            drawCircle(p.x, p.y, t.radius, t.r, t.g, t.b);
+            drawCircle(p.x, p.y, t.radius * 0.5f, t.r * 0.7f, t.g * 0.7f, t.b * 0.7f);
+
+            int health = enemies.health[i];
+            if (health > 1)
+                for (int j = 0; j < health; j++)
+                    drawLine(p.x - 10 + j * 7, p.y + t.radius + 5, p.x - 6 + j * 7, p.y + t.radius + 5, 1, 1, 0, true);
+        }
+    });
+
+    size_t particles = w.particleR.size();
+    size_t stride = (particles + quality.maxParticles - 1) / quality.maxParticles;
+    for (size_t i = 0; i < particles; i += std::max<size_t>(1, stride))
+        drawPoint(w.particleX[i], w.particleY[i], w.particleR[i] * 2, 1, 0.7f, 0);
+}
+
+// size is the line width or point size for this batch.
+static void submit(Batch& b, GLenum mode, float size) {
+    if (b.verts.empty()) return;
+    if (mode == GL_POINTS) glPointSize(size);
+    else glLineWidth(size);
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &b.verts[0].x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), b.verts[0].rgba);
+    glDrawArrays(mode, 0, (GLsizei)b.verts.size());
+    renderStats.drawCalls++;
+    renderStats.vertices += (int)b.verts.size();
+    b.verts.clear();
+}
+
+void flushBatches() {
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    submit(tris, GL_TRIANGLES, 1);
+    submit(lines, GL_LINES, 1);
+    submit(thickLines, GL_LINES, 2);
+    for (int s = 1; s <= MAX_POINT_SIZE; s++) submit(points[s], GL_POINTS, (float)s);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glLineWidth(1);
+}
+
+void discardBatches() {
+    tris.verts.clear(); lines.verts.clear(); thickLines.verts.clear();
+    for (int s = 0; s <= MAX_POINT_SIZE; s++) points[s].verts.clear();
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "render_frame.h"
+#include "quality.h"
+
+// Batched 2D renderer. The draw* calls only append vertices to per-primitive
+// client-side arrays; flushBatches() submits each non-empty array with one
+// glDrawArrays. Only flushBatches() and drawGrid() touch GL, so scenes can be
+// built (and benchmarked) without a context. Plain GL 1.1 vertex arrays, so it runs on
+// Mesa's llvmpipe.
+
+struct RenderStats { int drawCalls = 0, vertices = 0; };
+extern RenderStats renderStats;
+
+// Detail used by the draw* calls and drawScene(); full quality by default.
+void setRenderQuality(const RenderQuality& q);
+
+void drawCircle(float x, float y, float r, float R, float G, float B, bool filled = false);
+void drawGlow(float x, float y, float r, float R, float G, float B, float alpha = 0.3f);
+void drawSquare(float x, float y, float size, float rotation, float R, float G, float B);
+void drawStar(float x, float y, float size, float rotation, float R, float G, float B);
+void drawHeart(float x, float y, float size, bool filled);
+void drawRect(float x, float y, float w, float h, float R, float G, float B);
+void drawLine(float x0, float y0, float x1, float y1, float R, float G, float B, bool thick = false);
+void drawPoint(float x, float y, float size, float R, float G, float B);
+
+// Draws the background grid from a display list compiled on first use.
+void drawGrid();
+// Queues every entity in the frame; the grid and HUD are separate.
+// alpha in [0, 1] places moving entities between the previous tick (0) and
+// this one (1).
+void drawScene(const RenderFrame& w, float alpha = 1);
+void flushBatches();
+void discardBatches();
@@ -0,0 +1,144 @@
+#include "replay.h"
+#include <cmath>
+#include <cstring>
+
+static const char MAGIC[4] = { 'G', 'S', 'R', 'P' };
+static const uint32_t VERSION = 1;
+
+enum { HELD_FOLLOWS = 1, ACTIONS_FOLLOW = 2, AIM_FOLLOWS = 4 };
+
+static void putVarint(FILE* f, uint32_t v) {
+    while (v >= 0x80) { fputc((int)(v & 0x7f) | 0x80, f); v >>= 7; }
+    fputc((int)v, f);
+}
+
+static bool getVarint(FILE* f, uint32_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        int c = fgetc(f);
+        if (c == EOF) return false;
+        v |= (uint32_t)(c & 0x7f) << shift;
+        if (!(c & 0x80)) return true;
+    }
+    return false;
+}
+
+static uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static int32_t unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+static uint8_t heldBits(const Input& in) {
+    return in.up | in.down << 1 | in.left << 2 | in.right << 3 | in.fire << 4;
+}
+
+static uint8_t actionBits(const Input& in) {
+    return in.start | in.restart << 1 | in.menu << 2 | in.pause << 3 | in.dash << 4 | in.nuke << 5 | in.horde << 6;
+}
+
+static Input unpack(uint8_t held, uint8_t actions, int32_t aimX, int32_t aimY) {
+    Input in;
+    in.up = held & 1; in.down = held & 2; in.left = held & 4; in.right = held & 8; in.fire = held & 16;
+    in.start = actions & 1; in.restart = actions & 2; in.menu = actions & 4;
+    in.pause = actions & 8; in.dash = actions & 16; in.nuke = actions & 32; in.horde = actions & 64;
+    in.aimX = aimX / 16.0f;
+    in.aimY = aimY / 16.0f;
+    return in;
+}
+
+bool ReplayRecorder::open(const char* path, uint64_t seed, float dt) {
+    close();
+    file = fopen(path, "wb");
+    if (!file) return false;
+    fwrite(MAGIC, 1, 4, file);
+    fwrite(&VERSION, sizeof(VERSION), 1, file);
+    fwrite(&seed, sizeof(seed), 1, file);
+    fwrite(&dt, sizeof(dt), 1, file);
+    return true;
+}
+
+void ReplayRecorder::flushRun() {
+    if (!run) return;
+    fputc(0, file);
+    putVarint(file, run);
+    run = 0;
+}
+
+Input ReplayRecorder::record(const Input& in) {
+    uint8_t newHeld = heldBits(in), actions = actionBits(in);
+    int32_t x = (int32_t)lrintf(in.aimX * 16), y = (int32_t)lrintf(in.aimY * 16);
+    uint8_t flags = (newHeld != held ? HELD_FOLLOWS : 0) | (actions ? ACTIONS_FOLLOW : 0) |
+                    (x != aimX || y != aimY ? AIM_FOLLOWS : 0);
+    if (file && !flags) run++;
+    else if (file) {
+        flushRun();
+        fputc(flags, file);
+        if (flags & HELD_FOLLOWS) fputc(newHeld, file);
+        if (flags & ACTIONS_FOLLOW) fputc(actions, file);
+        if (flags & AIM_FOLLOWS) {
+            putVarint(file, zigzag(x - aimX));
+            putVarint(file, zigzag(y - aimY));
+        }
+    }
+    held = newHeld;
+    aimX = x;
+    aimY = y;
+    return unpack(held, actions, aimX, aimY);
+}
+
+void ReplayRecorder::close() {
+    if (!file) return;
+    flushRun();
+    fclose(file);
+    file = nullptr;
+}
+
+bool ReplayPlayer::open(const char* path) {
+    close();
+    file = fopen(path, "rb");
+    if (!file) return false;
+    char magic[4];
+    uint32_t version;
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, MAGIC, 4) ||
+        fread(&version, sizeof(version), 1, file) != 1 || version != VERSION ||
+        fread(&seed, sizeof(seed), 1, file) != 1 || fread(&dt, sizeof(dt), 1, file) != 1) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool ReplayPlayer::next(Input& in) {
+    if (!file) return false;
+    uint8_t actions = 0;
+    if (run) run--;
+    else {
+        int flags = fgetc(file);
+        if (flags == EOF) { close(); return false; }
+        if (!flags) {
+            if (!getVarint(file, run) || !run) { close(); return false; }
+            run--;
+        }
+        if (flags & HELD_FOLLOWS) {
+            int c = fgetc(file);
+            if (c == EOF) { close(); return false; }
+            held = (uint8_t)c;
+        }
+        if (flags & ACTIONS_FOLLOW) {
+            int c = fgetc(file);
+            if (c == EOF) { close(); return false; }
+            actions = (uint8_t)c;
+        }
+        if (flags & AIM_FOLLOWS) {
+            uint32_t dx, dy;
+            if (!getVarint(file, dx) || !getVarint(file, dy)) { close(); return false; }
+            aimX += unzigzag(dx);
+            aimY += unzigzag(dy);
+        }
+    }
+    in = unpack(held, actions, aimX, aimY);
+    return true;
+}
+
+void ReplayPlayer::close() {
+    if (file) fclose(file);
+    file = nullptr;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdio>
+#include <cstdint>
+#include "game.h"
+
+// Per-tick input recordings. A file is a 20-byte header (magic "GSRP",
+// version, seed, tick length) followed by one record per tick:
+//   flags byte: 1 = held buttons byte follows, 2 = actions byte follows,
+//               4 = aim delta follows as two zigzag varints in 1/16 px.
+//   flags 0 is a run: a varint count of ticks that repeat the previous held
+//   buttons and aim with no actions.
+// Held buttons and aim are only written when they change, so idle stretches
+// and steady movement cost a few bytes per second.
+
+class ReplayRecorder {
+public:
+    ~ReplayRecorder() { close(); }
+    bool open(const char* path, uint64_t seed, float dt);
+    bool isOpen() const { return file != nullptr; }
+    // Writes one tick and returns the input as the replay will reproduce it
+    // (aim rounded to 1/16 px). Step the returned input, not the original,
+    // or the replay will drift.
+    Input record(const Input& in);
+    void close();
+
+private:
+    void flushRun();
+    FILE* file = nullptr;
+    uint8_t held = 0;
+    int32_t aimX = 400 * 16, aimY = 300 * 16;
+    uint32_t run = 0;
+};
+
+class ReplayPlayer {
+public:
+    uint64_t seed = 0;
+    float dt = TICK;
+
+    ~ReplayPlayer() { close(); }
+    bool open(const char* path);
+    bool isOpen() const { return file != nullptr; }
+    // Fills in the next tick's input; false once the recording has ended.
+    bool next(Input& in);
+    void close();
+
+private:
+    FILE* file = nullptr;
+    uint8_t held = 0;
+    int32_t aimX = 400 * 16, aimY = 300 * 16;
+    uint32_t run = 0;
+};
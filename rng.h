@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+
+// PCG32 (O'Neill, pcg-random.org): small, fast and fully deterministic across
+// platforms, unlike rand(). Each World owns separate streams so cosmetic
+// effects never perturb gameplay rolls.
+struct Rng {
+    uint64_t state = 0x853c49e6748fea9bULL, inc = 0xda3e39cb94b95bdbULL;
+
+    void seed(uint64_t seed, uint64_t stream) {
+        state = 0;
+        inc = (stream << 1) | 1;
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+        uint32_t rot = (uint32_t)(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+    // Uniform integer in [0, n).
+    int range(int n) { return (int)(((uint64_t)next() * (uint32_t)n) >> 32); }
+};
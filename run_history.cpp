@@ -0,0 +1,155 @@
+#include "run_history.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char LOG_MAGIC[4] = { 'G', 'S', 'R', 'L' };
+static const char BOARD_MAGIC[4] = { 'G', 'S', 'L', 'B' };
+static const uint32_t VERSION = 1;
+
+// Both files start with a 16-byte header; the leaderboard's count says how
+// many of its LEADERBOARD_SIZE slots are filled.
+struct FileHeader { char magic[4]; uint32_t version, recordSize, count; };
+
+static uint32_t checksum(const RunRecord& r) {
+    uint32_t h = 2166136261u;
+    const unsigned char* p = (const unsigned char*)&r;
+    for (size_t i = 0; i < offsetof(RunRecord, check); i++) h = (h ^ p[i]) * 16777619u;
+    return h;
+}
+
+static bool writeAll(int fd, const void* data, size_t n) {
+    const char* p = (const char*)data;
+    while (n > 0) {
+        ssize_t w = ::write(fd, p, n);
+        if (w < 0) return false;
+        p += w;
+        n -= (size_t)w;
+    }
+    return true;
+}
+
+void RunHistory::open(const std::string& dir) {
+    logPath = dir + "/runs.log";
+    boardPath = dir + "/leaderboard.dat";
+
+    int fd = ::open(boardPath.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size == sizeof(FileHeader) + LEADERBOARD_SIZE * sizeof(RunRecord)) {
+        void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            const FileHeader* h = (const FileHeader*)map;
+            const RunRecord* records = (const RunRecord*)(h + 1);
+            if (!memcmp(h->magic, BOARD_MAGIC, 4) && h->version == VERSION && h->recordSize == sizeof(RunRecord))
+                for (uint32_t i = 0; i < std::min<uint32_t>(h->count, LEADERBOARD_SIZE); i++)
+                    if (records[i].check == checksum(records[i])) board.push_back(records[i]);
+            munmap(map, st.st_size);
+        }
+    }
+    if (fd >= 0) ::close(fd);
+    boardVersion++;
+
+    running = true;
+    thread = std::thread(&RunHistory::run, this);
+}
+
+void RunHistory::stop() {
+    if (!thread.joinable()) return;
+    running = false;
+    wake.notify_one();
+    thread.join();
+}
+
+bool RunHistory::submit(const World& w, long tick) {
+    RunRecord r;
+    memset(&r, 0, sizeof r);
+    r.seed = w.seed;
+    r.endedAt = (int64_t)time(nullptr);
+    r.endTick = tick;
+    r.score = w.score;
+    r.wave = w.wave;
+    r.mode = w.mode;
+    r.survivalTime = w.survivalTime;
+    strncpy(r.replay, replayRef.c_str(), sizeof r.replay - 1);
+    r.check = checksum(r);
+    if (!pending.push(r)) return false;
+    wake.notify_one();
+    return true;
+}
+
+bool RunHistory::top(std::vector<RunRecord>& out, unsigned& seen) const {
+    unsigned version = boardVersion.load();
+    if (version == seen) return false;
+    std::lock_guard<std::mutex> lock(boardMutex);
+    out.assign(board.begin(), board.end());
+    seen = version;
+    return true;
+}
+
+int RunHistory::best() const {
+    std::lock_guard<std::mutex> lock(boardMutex);
+    return board.empty() ? 0 : board[0].score;
+}
+
+// Drains the queue until stop(). Waits are bounded because submit() notifies
+// without taking the lock and a wakeup can slip between the check and the wait.
+void RunHistory::run() {
+    for (;;) {
+        bool stopping = !running;
+        RunRecord r;
+        while (pending.pop(r)) write(r);
+        if (stopping) return;
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait_for(lock, std::chrono::milliseconds(200));
+    }
+}
+
+void RunHistory::write(RunRecord r) {
+    int fd = ::open(logPath.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd >= 0) {
+        // Cut off a record torn by a crash so later ones stay aligned.
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            off_t end = st.st_size;
+            if (end < (off_t)sizeof(FileHeader)) {
+                FileHeader h = { { LOG_MAGIC[0], LOG_MAGIC[1], LOG_MAGIC[2], LOG_MAGIC[3] }, VERSION, sizeof(RunRecord), 0 };
+                end = ftruncate(fd, 0) == 0 && writeAll(fd, &h, sizeof h) ? (off_t)sizeof h : -1;
+            }
+            else end -= (end - sizeof(FileHeader)) % sizeof(RunRecord);
+            if (end >= 0 && lseek(fd, end, SEEK_SET) == end && writeAll(fd, &r, sizeof r) && ftruncate(fd, end + sizeof r) == 0)
+                fdatasync(fd);
+        }
+        ::close(fd);
+    }
+
+    std::vector<RunRecord> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(boardMutex);
+        auto at = std::upper_bound(board.begin(), board.end(), r,
+                                   [](const RunRecord& a, const RunRecord& b) { return a.score > b.score; });
+        if (at - board.begin() >= LEADERBOARD_SIZE) return;
+        board.insert(at, r);
+        if ((int)board.size() > LEADERBOARD_SIZE) board.pop_back();
+        boardVersion++;
+        snapshot = board;
+    }
+
+    std::string tmp = boardPath + ".tmp";
+    fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return;
+    FileHeader h = { { BOARD_MAGIC[0], BOARD_MAGIC[1], BOARD_MAGIC[2], BOARD_MAGIC[3] }, VERSION, sizeof(RunRecord),
+                     (uint32_t)snapshot.size() };
+    snapshot.resize(LEADERBOARD_SIZE, RunRecord());
+    bool ok = writeAll(fd, &h, sizeof h) && writeAll(fd, snapshot.data(), snapshot.size() * sizeof(RunRecord)) && fsync(fd) == 0;
+    ::close(fd);
+    if (!ok || rename(tmp.c_str(), boardPath.c_str()) != 0) { unlink(tmp.c_str()); return; }
+    // The rename itself is only durable once the directory is synced.
+    std::string dir = boardPath.substr(0, boardPath.find_last_of('/'));
+    int dirFd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dirFd >= 0) { fsync(dirFd); ::close(dirFd); }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "game.h"
+#include "spsc_queue.h"
+
+// One finished game. Fixed size so the run log is a flat array after its
+// header; check is an FNV-1a hash of the other fields, so a record torn by a
+// crash mid-append is recognised and skipped.
+struct RunRecord {
+    uint64_t seed;
+    int64_t endedAt;  // unix time
+    int64_t endTick;  // tick of the session (and of its replay) the game ended on
+    int32_t score, wave, mode;
+    float survivalTime;
+    char replay[40];  // replay file recording the session, or empty
+    uint32_t check;
+};
+
+const int LEADERBOARD_SIZE = 10;
+
+// Persistent run history. submit() is called by the simulation thread at
+// game over and only pushes onto a lock-free queue; a background thread
+// appends each record to the run log with fdatasync and rewrites the
+// leaderboard through a temporary file, fsync and rename, so neither file is
+// ever left half-written. The leaderboard is the top LEADERBOARD_SIZE runs
+// by score and is memory-mapped at open(), so startup does no parsing.
+class RunHistory {
+public:
+    std::string replayRef;  // set before start(); stored with every run
+
+    ~RunHistory() { stop(); }
+    // Loads the leaderboard from dir and starts the I/O thread.
+    void open(const std::string& dir);
+    void stop();
+    bool submit(const World& w, long tick);
+    // Copies the leaderboard, best first, into out if it changed since the
+    // version in seen, and updates seen; out keeps its capacity, so polling
+    // every frame does not allocate. Returns true if out was refreshed.
+    bool top(std::vector<RunRecord>& out, unsigned& seen) const;
+    int best() const;
+
+private:
+    void run();
+    void write(RunRecord r);
+    std::string logPath, boardPath;
+    SpscQueue<RunRecord, 64> pending;
+    std::thread thread;
+    std::atomic<bool> running{ false };
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    mutable std::mutex boardMutex;
+    std::vector<RunRecord> board;
+    std::atomic<unsigned> boardVersion{ 1 };  // bumped on every change to board
+};
@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "coop.h"
+#include "game.h"
+
+// Authoritative co-op server: runs the World at a fixed tick rate for up to
+// MAX_PLAYERS clients over UDP and sends each a snapshot every tick. Prints
+// the simulation and replication cost and the bytes sent once a second and
+// in total on exit.
+
+static volatile std::sig_atomic_t stopRequested = 0;
+static void onSignal(int) { stopRequested = 1; }
+
+// Inputs from one client, indexed by sequence number.
+const int INPUT_RING = 64;
+// How far the newest input may run ahead of the one applied before the
+// backlog is skipped; a client whose clock runs fast would otherwise lag
+// further behind every second.
+const uint32_t MAX_INPUT_BACKLOG = 8;
+
+struct Client {
+    bool connected = false;
+    NetAddress addr;
+    long lastHeard = 0, ack = 0;
+    uint32_t applied = 0, newest = 0;
+    uint32_t seqs[INPUT_RING] = {};
+    Input inputs[INPUT_RING];
+    Input last;
+    NetView history[COOP_HISTORY];
+    long long bytes = 0;
+    long snapshots = 0, deltas = 0, stalls = 0;
+};
+
+// The held part of an input, repeated when a client's next input is late.
+static Input held(const Input& in) {
+    Input r;
+    r.up = in.up; r.down = in.down; r.left = in.left; r.right = in.right; r.fire = in.fire;
+    r.aimX = in.aimX; r.aimY = in.aimY;
+    return r;
+}
+
+static float percentile(std::vector<float> v, float q) {
+    if (v.empty()) return 0;
+    size_t i = std::min(v.size() - 1, (size_t)(q * v.size()));
+    std::nth_element(v.begin(), v.begin() + i, v.end());
+    return v[i];
+}
+
+static float mean(const std::vector<float>& v) {
+    double s = 0;
+    for (float x : v) s += x;
+    return v.empty() ? 0 : (float)(s / v.size());
+}
+
+int main(int argc, char** argv) {
+    int port = COOP_PORT, tickRate = 60;
+    uint64_t seed = 1;
+    long ticks = 0;
+    float timeout = 5;
+    int hordeHealth = 0;
+    Replicator replicator;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--port") && i + 1 < argc) port = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--tick-rate") && i + 1 < argc) tickRate = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) ticks = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--interest") && i + 1 < argc) replicator.radius = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--packet-bytes") && i + 1 < argc) replicator.maxBytes = (size_t)atol(argv[++i]);
+        else if (!strcmp(argv[i], "--timeout") && i + 1 < argc) timeout = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "--horde-health") && i + 1 < argc) hordeHealth = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--port N] [--seed S] [--tick-rate HZ] [--ticks N] [--interest PX] [--packet-bytes N]\n"
+                            "       [--timeout S] [--horde-health N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (tickRate <= 0) { fprintf(stderr, "--tick-rate must be positive\n"); return 1; }
+    if (replicator.maxBytes < 256 || replicator.maxBytes > 65000) { fprintf(stderr, "--packet-bytes must be 256 to 65000\n"); return 1; }
+    float dt = 1.0f / tickRate;
+
+    UdpSocket sock;
+    if (!sock.open(port)) { fprintf(stderr, "cannot listen on UDP port %d\n", port); return 1; }
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    printf("listening on UDP port %d, %d Hz, seed %llu\n", port, tickRate, (unsigned long long)seed);
+    fflush(stdout);
+
+    World world;
+    seedWorld(world, seed);
+    if (hordeHealth > 0) world.config.horde.startHealth = hordeHealth;
+    static Client clients[MAX_PLAYERS];
+    std::vector<uint8_t> packet;
+    static uint8_t buf[65536];
+    std::vector<float> simMs, replicateMs, tickBytes;
+    long windowStart = 1;
+    int peakClients = 0;
+    size_t peakEnemies = 0, maxSnapshot = 0;
+
+    using clock = std::chrono::steady_clock;
+    auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(dt));
+    auto due = clock::now();
+    long tick = 0;
+    while (!stopRequested && (ticks <= 0 || tick < ticks)) {
+        due += period;
+        std::this_thread::sleep_until(due);
+        if (clock::now() - due > period * 5) due = clock::now();
+        tick++;
+
+        NetAddress from;
+        long n;
+        while ((n = sock.receive(buf, sizeof buf, from)) > 0) {
+            ByteReader in{ buf, (size_t)n };
+            uint8_t type = in.u8();
+            int slot = -1;
+            for (int s = 0; s < MAX_PLAYERS; s++)
+                if (clients[s].connected && clients[s].addr == from) slot = s;
+            if (type == PK_HELLO) {
+                if (in.u32() != COOP_PROTOCOL) continue;
+                if (slot < 0) {
+                    // The first client flies the player's ship and drives the menus.
+                    if (!clients[0].connected) slot = 0;
+                    else {
+                        int ally = joinAlly(world);
+                        slot = ally < 0 ? -1 : ally + 1;
+                    }
+                    if (slot < 0) {
+                        uint8_t full = PK_FULL;
+                        sock.send(from, &full, 1);
+                        continue;
+                    }
+                    clients[slot] = Client();
+                    clients[slot].connected = true;
+                    clients[slot].addr = from;
+                    printf("client %d joined\n", slot);
+                }
+                clients[slot].lastHeard = tick;
+                packet.clear();
+                ByteWriter out{ packet };
+                out.u8(PK_WELCOME);
+                out.u8((uint8_t)slot);
+                out.varint((uint64_t)tickRate);
+                out.varint(seed);
+                sock.send(from, packet.data(), packet.size());
+            }
+            else if (slot < 0) continue;
+            else if (type == PK_INPUT) {
+                Client& c = clients[slot];
+                c.lastHeard = tick;
+                long ack = (long)in.varint();
+                uint32_t first = (uint32_t)in.varint();
+                int count = in.u8();
+                if (!in.ok || ack > tick) continue;
+                c.ack = std::max(c.ack, ack);
+                for (int i = 0; i < count; i++) {
+                    uint32_t seq = first + i;
+                    Input input = readNetInput(in);
+                    if (!in.ok) break;
+                    if (seq <= c.applied || seq - c.applied > INPUT_RING) continue;
+                    c.seqs[seq % INPUT_RING] = seq;
+                    c.inputs[seq % INPUT_RING] = input;
+                    c.newest = std::max(c.newest, seq);
+                }
+            }
+            else if (type == PK_BYE) {
+                clients[slot].lastHeard = -1000000;
+            }
+        }
+
+        int connected = 0;
+        Input inputs[MAX_PLAYERS];
+        for (int s = 0; s < MAX_PLAYERS; s++) {
+            Client& c = clients[s];
+            if (c.connected && (tick - c.lastHeard) * dt > timeout) {
+                c.connected = false;
+                if (s > 0) leaveAlly(world, s - 1);
+                printf("client %d left\n", s);
+            }
+            if (!c.connected) continue;
+            connected++;
+            if (c.newest > c.applied + MAX_INPUT_BACKLOG) c.applied = c.newest - 2;
+            uint32_t next = c.applied + 1;
+            if (c.seqs[next % INPUT_RING] == next) {
+                c.last = c.inputs[next % INPUT_RING];
+                c.applied = next;
+                inputs[s] = c.last;
+            }
+            else {
+                inputs[s] = held(c.last);
+                c.stalls++;
+            }
+        }
+        peakClients = std::max(peakClients, connected);
+
+        auto t0 = clock::now();
+        step(world, inputs[0], dt, inputs + 1);
+        auto t1 = clock::now();
+        long long sent = 0;
+        for (int s = 0; s < MAX_PLAYERS; s++) {
+            Client& c = clients[s];
+            if (!c.connected) continue;
+            NetHeader h;
+            fillHeader(world, s, h);
+            h.tick = tick;
+            h.inputSeq = c.applied;
+            const NetView& b = c.history[c.ack % COOP_HISTORY];
+            const NetView* base = c.ack > 0 && b.tick == c.ack && tick - c.ack < COOP_HISTORY ? &b : nullptr;
+            h.baseline = base ? c.ack : 0;
+            replicator.build(world, h, h.shipPos, base, c.history[tick % COOP_HISTORY], packet);
+            sock.send(c.addr, packet.data(), packet.size());
+            c.bytes += (long long)packet.size();
+            c.snapshots++;
+            c.deltas += base != nullptr;
+            sent += (long long)packet.size();
+            maxSnapshot = std::max(maxSnapshot, packet.size());
+        }
+        auto t2 = clock::now();
+        simMs.push_back(std::chrono::duration<float, std::milli>(t1 - t0).count());
+        replicateMs.push_back(std::chrono::duration<float, std::milli>(t2 - t1).count());
+        tickBytes.push_back((float)sent);
+        peakEnemies = std::max(peakEnemies, world.enemies.size());
+
+        if (tick - windowStart + 1 == tickRate) {
+            auto window = [&](const std::vector<float>& v) { return std::vector<float>(v.end() - tickRate, v.end()); };
+            std::vector<float> sim = window(simMs), rep = window(replicateMs), bytes = window(tickBytes);
+            printf("tick %ld  clients %d  enemies %zu  sim ms %.2f (p99 %.2f)  replicate ms %.2f (p99 %.2f)  bytes/tick %.0f (%.0f per client)\n",
+                   tick, connected, world.enemies.size(), mean(sim), percentile(sim, 0.99f), mean(rep), percentile(rep, 0.99f),
+                   mean(bytes), connected ? mean(bytes) / connected : 0.0f);
+            fflush(stdout);
+            windowStart = tick + 1;
+        }
+    }
+
+    uint8_t bye = PK_BYE;
+    for (const Client& c : clients)
+        if (c.connected) sock.send(c.addr, &bye, 1);
+    printf("ticks %ld  peak clients %d  peak enemies %zu\n", tick, peakClients, peakEnemies);
+    printf("sim ms per tick mean %.3f  p50 %.3f  p99 %.3f  max %.3f\n", mean(simMs), percentile(simMs, 0.5f),
+           percentile(simMs, 0.99f), percentile(simMs, 1));
+    printf("replication ms per tick mean %.3f  p50 %.3f  p99 %.3f  max %.3f\n", mean(replicateMs), percentile(replicateMs, 0.5f),
+           percentile(replicateMs, 0.99f), percentile(replicateMs, 1));
+    printf("bytes per tick mean %.0f  p99 %.0f  largest snapshot %zu\n", mean(tickBytes), percentile(tickBytes, 0.99f), maxSnapshot);
+    for (int s = 0; s < MAX_PLAYERS; s++) {
+        const Client& c = clients[s];
+        if (!c.snapshots) continue;
+        printf("client %d  snapshots %ld  bytes/snapshot %.0f  delta-coded %.1f%%  late inputs %ld\n", s, c.snapshots,
+               (double)c.bytes / c.snapshots, 100.0 * c.deltas / c.snapshots, c.stalls);
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "sim_thread.h"
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+void SimThread::start(float tickSeconds) {
+    dt = tickSeconds;
+    rewindEvery = std::max(1L, std::lround(1 / dt));
+    profiler.threadName = "simulation";
+    publish(std::chrono::steady_clock::now());
+    running = true;
+    thread = std::thread(&SimThread::run, this);
+}
+
+void SimThread::stop() {
+    running = false;
+    if (thread.joinable()) thread.join();
+    recorder.close();
+}
+
+// Runs one tick; lateMs is how long after its due time it started.
+void SimThread::tick(float lateMs) {
+    using clock = std::chrono::steady_clock;
+    // Mouse moves are too frequent to be worth a latency sample each.
+    InputEvent ev;
+    while (inputs.pop(ev)) {
+        input.apply(ev, world.gameState);
+        if (ev.type != MOUSE_MOVE) inputStamps.push({ ticks + 1, ev.timeNs });
+    }
+    Input in = input.sample();
+    if (replay.isOpen()) replay.next(in);
+    if (recorder.isOpen()) in = recorder.record(in);
+
+    if (rewindRequests.exchange(0) > 0 && rewind.size() && world.gameState != MENU) {
+        if (recorder.isOpen() || replay.isOpen()) fprintf(stderr, "rewind is disabled while recording or replaying\n");
+        else {
+            size_t back = 0;
+            while (back + 1 < rewind.size() && rewind.tickAt(back) > ticks - rewindEvery) back++;
+            long at;
+            if (rewind.restore(back, world, at)) ticks = at;
+        }
+    }
+    if (saveRequested.exchange(false)) {
+        if (writeSnapshotFile("snapshot.gss", world, ticks)) fprintf(stderr, "saved snapshot.gss at tick %ld\n", ticks);
+        else fprintf(stderr, "cannot write snapshot.gss\n");
+    }
+    float survivedBefore = world.survivalTime;
+
+    bool profile = profiling || profiler.tracing;
+    world.profiler = profile ? &profiler : nullptr;
+    profiler.clear();
+    GameState before = world.gameState;
+    auto start = clock::now();
+    step(world, in, dt);
+    auto end = clock::now();
+    ticks++;
+    if (history && before != GAME_OVER && world.gameState == GAME_OVER && !history->submit(world, ticks))
+        fprintf(stderr, "run history queue full; run not saved\n");
+    // resetGame() zeroes the survival time: a new game cannot rewind into the last one.
+    if (world.survivalTime < survivedBefore) rewind.clear();
+    if (world.gameState == PLAYING && ticks % rewindEvery == 0) rewind.capture(world, ticks);
+
+    tickMs = std::chrono::duration<float, std::milli>(end - start).count();
+    jitter.add(lateMs);
+    if (budget.check(tickMs) && ticks - lastReport >= 60) {
+        fprintf(stderr, "tick %ld took %.1f ms (budget %.0f ms, %ld overruns, %zu enemies)\n",
+                ticks, tickMs, budget.budgetMs, budget.overruns, world.enemies.size());
+        lastReport = ticks;
+    }
+    if (profile) {
+        profiler.add(PH_TICK, start, end);
+        tickTimes.add(tickMs);
+    }
+}
+
+void SimThread::publish(std::chrono::steady_clock::time_point due) {
+    RenderFrame& frame = frames.writeBuffer();
+    captureFrame(world, ticks, frame);
+    frame.tickDueNs = std::chrono::duration_cast<std::chrono::nanoseconds>(due.time_since_epoch()).count();
+    frame.tickSeconds = dt;
+    frame.jitterP50 = jitter.percentile(0.5f);
+    frame.jitterP99 = jitter.percentile(0.99f);
+    frame.droppedTicks = droppedTicks;
+    frame.tickMs = tickMs;
+    frame.overruns = budget.overruns;
+    frame.worstTickMs = budget.worstMs;
+    frame.snapshotUs = rewind.lastNs / 1e3f;
+    frame.snapshotWorstUs = rewind.worstNs / 1e3f;
+    frame.rewindSnapshots = (long)rewind.size();
+    frame.rewindBytes = (long)rewind.bytes();
+    frame.profiled = world.profiler != nullptr;
+    if (frame.profiled) {
+        frame.tickP50 = tickTimes.percentile(0.5f);
+        frame.tickP99 = tickTimes.percentile(0.99f);
+        for (int p = 0; p < SIM_PHASES_END; p++) frame.phaseMs[p] = profiler.ns[p] / 1e6f;
+    }
+    frames.publish();
+}
+
+// Fixed-timestep accumulator on the monotonic clock. simTime is the wall time
+// the simulation has caught up to; every whole period behind it owes one
+// tick. Work time therefore never stretches the period. After a stall at
+// most MAX_CATCH_UP ticks run back to back and the rest of the backlog is
+// dropped, so the game slows down briefly instead of spiralling.
+void SimThread::run() {
+    using clock = std::chrono::steady_clock;
+    const int MAX_CATCH_UP = 5;
+    const auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(dt));
+    auto simTime = clock::now();
+    while (running) {
+        auto now = clock::now();
+        int steps = 0;
+        for (; now - simTime >= period && steps < MAX_CATCH_UP; steps++) {
+            simTime += period;
+            tick(std::chrono::duration<float, std::milli>(now - simTime).count());
+            now = clock::now();
+        }
+        if (now - simTime >= period) {
+            long behind = (long)((now - simTime) / period);
+            droppedTicks += behind;
+            simTime += behind * period;
+        }
+        if (steps) publish(simTime);
+        std::this_thread::sleep_until(simTime + period);
+    }
+}
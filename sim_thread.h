@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "game.h"
+#include "input.h"
+#include "render_frame.h"
+#include "replay.h"
+#include "run_history.h"
+#include "snapshot.h"
+#include "spsc_queue.h"
+#include "triple_buffer.h"
+
+// Runs the simulation on its own thread at a fixed tick rate. Window input
+// arrives over a lock-free queue and each batch of ticks publishes a
+// RenderFrame through a triple buffer, so a slow display() never delays a
+// tick and the two overlap on separate cores.
+class SimThread {
+public:
+    World world;  // only touched by the simulation thread once started
+    TripleBuffer<RenderFrame> frames;
+    SpscQueue<InputEvent, 1024> inputs;
+    // Key and button events stamped with the tick that consumed them.
+    SpscQueue<InputStamp, 1024> inputStamps;
+    // Open before start(). While a replay lasts it drives the game instead of
+    // the window; every tick is written to an open recorder.
+    ReplayPlayer replay;
+    ReplayRecorder recorder;
+    RunHistory* history = nullptr;  // gets every finished game when set
+    // Requests from the window. A rewind returns to the newest snapshot at
+    // least a second old; rewinds are ignored while recording or replaying,
+    // which they would desynchronise. saveRequested writes snapshot.gss.
+    std::atomic<int> rewindRequests{ 0 };
+    std::atomic<bool> saveRequested{ false };
+    // Per-phase timing of every tick, shown through RenderFrame. The trace
+    // in profiler may only be read after stop().
+    std::atomic<bool> profiling{ false };
+    Profiler profiler;
+
+    ~SimThread() { stop(); }
+    void start(float tickSeconds);
+    void stop();
+
+private:
+    void run();
+    void tick(float lateMs);
+    void publish(std::chrono::steady_clock::time_point due);
+    std::thread thread;
+    std::atomic<bool> running{ false };
+    float dt = TICK;
+    InputState input;
+    long ticks = 0, lastReport = -60, droppedTicks = 0;
+    float tickMs = 0;
+    RollingTimes tickTimes, jitter;
+    FrameBudget budget;
+    RewindBuffer rewind;  // one snapshot per second of play
+    long rewindEvery = 60;
+};
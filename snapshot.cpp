@@ -0,0 +1,275 @@
+#include "snapshot.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+static const char MAGIC[4] = { 'G', 'S', 'S', 'N' };
+static const uint32_t VERSION = 5;
+
+struct Writer {
+    std::vector<uint8_t>& out;
+    template <typename T>
+    void operator()(const T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshots store raw bytes");
+        array(&v, 1);
+    }
+    template <typename T>
+    void array(const T* p, size_t n) {
+        const uint8_t* b = (const uint8_t*)p;
+        out.insert(out.end(), b, b + n * sizeof(T));
+    }
+};
+
+struct Reader {
+    const uint8_t* data;
+    size_t size, pos = 0;
+    bool ok = true;
+    template <typename T>
+    void operator()(T& v) { array(&v, 1); }
+    template <typename T>
+    void array(T* p, size_t n) {
+        if (!ok || n * sizeof(T) > size - pos) { ok = false; return; }
+        memcpy((void*)p, data + pos, n * sizeof(T));
+        pos += n * sizeof(T);
+    }
+};
+
+// Every piece of non-derived World state outside the pools, in file order.
+// Shared by saving and loading so the two cannot drift apart.
+template <typename Io, typename W>
+static void scalars(Io& io, W& w) {
+    io(w.seed); io(w.rng); io(w.fxRng);
+    io(w.player); io(w.playerPrev); io(w.playerTrail);
+    io(w.score); io(w.highScore); io(w.ammo); io(w.nukes); io(w.playerHealth); io(w.maxHealth);
+    io(w.wave); io(w.enemiesLeftInWave); io(w.comboCount);
+    io(w.spawnTimer); io(w.ammoSpawnTimer); io(w.powerUpSpawnTimer); io(w.shootCooldown);
+    io(w.dashCooldown); io(w.rapidFireTimer); io(w.waveTransitionTimer); io(w.comboTimer);
+    io(w.screenShakeX); io(w.screenShakeY); io(w.screenShakeIntensity); io(w.survivalTime);
+    io(w.slowMoTimer); io(w.trailTimer); io(w.hasShield); io(w.gameState); io(w.mode);
+    io(w.nextId); io(w.allies);
+}
+
+// An archetype is its row count followed by each column in turn.
+template <typename A>
+static void savePool(Writer& out, const A& pool) {
+    out((uint32_t)pool.size());
+    A::columns(pool, [&](const auto& c) { out.array(c.data(), c.size()); });
+}
+
+template <typename A>
+static void loadPool(Reader& in, A& pool) {
+    uint32_t n = 0;
+    in(n);
+    pool.clear();
+    if (!in.ok || !pool.assign(n)) { in.ok = false; return; }
+    A::columns(pool, [&](auto& c) { in.array(c.data(), c.size()); });
+}
+
+void saveSnapshot(const World& w, long tick, std::vector<uint8_t>& out) {
+    out.clear();
+    Writer wr{ out };
+    wr.array(MAGIC, 4);
+    wr(VERSION);
+    wr((int64_t)tick);
+    wr(w.config);
+    scalars(wr, w);
+    savePool(wr, w.bullets);
+    savePool(wr, w.enemies);
+    savePool(wr, w.ammoBoxes);
+    savePool(wr, w.powerUps);
+    const ParticleSystem& p = w.particles;
+    wr((uint32_t)p.count);
+    for (const std::vector<float>* a : { &p.x, &p.y, &p.vx, &p.vy, &p.r }) wr.array(a->data(), p.count);
+}
+
+// Pool sizes are read before anything is allocated from them.
+static bool validConfig(const WorldConfig& c) {
+    const int MAX_CAPACITY = 1 << 20;
+    for (int cap : { c.maxBullets, c.maxEnemies, c.maxAmmoBoxes, c.maxPowerUps, c.maxParticles })
+        if (cap <= 0 || cap > MAX_CAPACITY) return false;
+    return true;
+}
+
+// A bool is only safe to use if its byte is 0 or 1.
+static bool validBool(const bool& b) {
+    uint8_t v;
+    memcpy(&v, &b, 1);
+    return v <= 1;
+}
+
+template <int N>
+static bool validTrail(const TrailRing<N>& t) { return t.head < N && t.count <= N; }
+
+// Values read raw from a snapshot that index tables or arrays later on.
+static bool validState(const World& w) {
+    if ((int)w.gameState < MENU || (int)w.gameState > WAVE_TRANSITION || ((int)w.mode != CLASSIC && (int)w.mode != HORDE)) return false;
+    if (!validBool(w.player.alive) || !validBool(w.hasShield) || !validTrail(w.playerTrail)) return false;
+    for (const Ally& a : w.allies)
+        if (!validBool(a.joined) || !validBool(a.ship.alive) || !validTrail(a.trail)) return false;
+    for (const BulletTrail& t : w.bullets.trail)
+        if (!validTrail(t)) return false;
+    for (int type : w.powerUps.type)
+        if (type < 0 || type >= POWERUP_TYPES) return false;
+    return true;
+}
+
+// Decodes into w, which may be left half written on failure.
+static bool decodeSnapshot(World& w, const uint8_t* data, size_t size, long& tick) {
+    Reader rd{ data, size };
+    char magic[4];
+    uint32_t version = 0;
+    int64_t at = 0;
+    rd.array(magic, 4);
+    rd(version);
+    rd(at);
+    if (!rd.ok || memcmp(magic, MAGIC, 4) || version != VERSION) return false;
+    rd(w.config);
+    if (!rd.ok || !validConfig(w.config)) return false;
+    allocateWorld(w);
+    scalars(rd, w);
+    loadPool(rd, w.bullets);
+    loadPool(rd, w.enemies);
+    loadPool(rd, w.ammoBoxes);
+    loadPool(rd, w.powerUps);
+    ParticleSystem& p = w.particles;
+    uint32_t particles = 0;
+    rd(particles);
+    if (!rd.ok || (int)particles > p.capacity()) return false;
+    p.count = (int)particles;
+    for (std::vector<float>* a : { &p.x, &p.y, &p.vx, &p.vy, &p.r }) rd.array(a->data(), particles);
+    if (!rd.ok || rd.pos != size || !w.enemies.regroup() || !validState(w)) return false;
+    tick = (long)at;
+    return true;
+}
+
+bool loadSnapshot(World& w, const uint8_t* data, size_t size, long& tick) {
+    World loaded;
+    if (!decodeSnapshot(loaded, data, size, tick)) return false;
+    loaded.profiler = w.profiler;
+    std::swap(w, loaded);
+    return true;
+}
+
+bool writeSnapshotFile(const char* path, const World& w, long tick) {
+    std::vector<uint8_t> buf;
+    saveSnapshot(w, tick, buf);
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+    return fclose(f) == 0 && ok;
+}
+
+bool readSnapshotFile(const char* path, World& w, long& tick) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    std::vector<uint8_t> buf;
+    uint8_t chunk[1 << 16];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof chunk, f)) > 0) buf.insert(buf.end(), chunk, chunk + n);
+    fclose(f);
+    return loadSnapshot(w, buf.data(), buf.size(), tick);
+}
+
+static void putVarint(std::vector<uint8_t>& out, size_t v) {
+    while (v >= 0x80) { out.push_back((uint8_t)(v | 0x80)); v >>= 7; }
+    out.push_back((uint8_t)v);
+}
+
+static size_t getVarint(const uint8_t*& p) {
+    size_t v = 0;
+    for (int shift = 0;; shift += 7) {
+        v |= (size_t)(*p & 0x7f) << shift;
+        if (!(*p++ & 0x80)) return v;
+    }
+}
+
+// XOR of cur against key (zero past the end of key), as alternating varint
+// zero-run and literal-run lengths with the literal bytes after each.
+// Literal runs only end at 8 or more zero bytes, so short matches inside a
+// changed region do not cost two varints each.
+static void encodeDelta(const std::vector<uint8_t>& cur, const std::vector<uint8_t>& key, std::vector<uint8_t>& out) {
+    out.clear();
+    size_t n = cur.size(), m = key.size(), i = 0;
+    auto x = [&](size_t j) { return (uint8_t)(cur[j] ^ (j < m ? key[j] : 0)); };
+    while (i < n) {
+        size_t zeros = i;
+        while (zeros < n && !x(zeros)) zeros++;
+        putVarint(out, zeros - i);
+        i = zeros;
+        size_t end = i, run = 0;
+        while (end < n && run < 8) {
+            run = x(end) ? 0 : run + 1;
+            end++;
+        }
+        if (run >= 8) end -= run;
+        putVarint(out, end - i);
+        for (; i < end; i++) out.push_back(x(i));
+    }
+}
+
+static void decodeDelta(const std::vector<uint8_t>& delta, const std::vector<uint8_t>& key, size_t size, std::vector<uint8_t>& out) {
+    out.resize(size);
+    const uint8_t* p = delta.data();
+    const uint8_t* end = p + delta.size();
+    size_t m = key.size(), i = 0;
+    auto k = [&](size_t j) { return j < m ? key[j] : (uint8_t)0; };
+    while (p < end) {
+        for (size_t z = getVarint(p); z > 0; z--, i++) out[i] = k(i);
+        for (size_t l = getVarint(p); l > 0; l--, i++) out[i] = *p++ ^ k(i);
+    }
+}
+
+void RewindBuffer::capture(const World& w, long tick) {
+    auto start = std::chrono::steady_clock::now();
+    if (ring.size() != (size_t)slots) { ring.assign(slots, Slot()); head = count = 0; }
+    saveSnapshot(w, tick, scratch);
+
+    bool keyframe = count == 0 || sinceKeyframe >= keyframeInterval;
+    if (count == ring.size()) {
+        head = (head + 1) % ring.size();
+        count--;
+        while (count > 0 && !at(0).keyframe) { head = (head + 1) % ring.size(); count--; }
+        if (count == 0) keyframe = true;
+    }
+    Slot& s = at(count);
+    s.tick = tick;
+    s.keyframe = keyframe;
+    s.fullSize = scratch.size();
+    if (keyframe) {
+        s.data.assign(scratch.begin(), scratch.end());
+        sinceKeyframe = 0;
+    }
+    else {
+        size_t k = count;
+        while (!at(--k).keyframe) {}
+        encodeDelta(scratch, at(k).data, s.data);
+    }
+    count++;
+    sinceKeyframe++;
+
+    lastNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    worstNs = std::max(worstNs, lastNs);
+    totalNs += lastNs;
+    captures++;
+}
+
+size_t RewindBuffer::bytes() const {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) total += ring[(head + i) % ring.size()].data.size();
+    return total;
+}
+
+bool RewindBuffer::restore(size_t back, World& w, long& tick) {
+    if (back >= count) return false;
+    size_t i = count - 1 - back, k = i;
+    while (!at(k).keyframe) k--;
+    const Slot& s = at(i);
+    if (s.keyframe) decoded.assign(s.data.begin(), s.data.end());
+    else decodeDelta(s.data, at(k).data, s.fullSize, decoded);
+    if (!loadSnapshot(w, decoded.data(), decoded.size(), tick)) return false;
+    count = i + 1;
+    sinceKeyframe = (int)(i - k) + 1;
+    return true;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "game.h"
+
+// Binary world snapshots. A snapshot is a flat byte buffer: a header (magic
+// "GSSN", version, session tick), the config, both RNG streams and every
+// scalar, then each archetype as a count followed by its columns. Derived
+// state (flow field, spatial grid, pending events) is not stored; the flow
+// field is rebuilt on the next tick. Loading a snapshot and stepping it gives
+// the same game as stepping the original, so a snapshot plus a replay or the
+// autopilot reproduces a run from that moment on.
+
+// Appends the snapshot to out, which is cleared first.
+void saveSnapshot(const World& w, long tick, std::vector<uint8_t>& out);
+// Restores a snapshot into w, keeping its profiler; false if data is not a
+// valid snapshot of this version, in which case w is unchanged. tick
+// receives the session tick.
+bool loadSnapshot(World& w, const uint8_t* data, size_t size, long& tick);
+bool writeSnapshotFile(const char* path, const World& w, long tick);
+bool readSnapshotFile(const char* path, World& w, long& tick);
+
+// In-memory rewind history: a ring of snapshots, each stored as a delta
+// against the keyframe before it. Deltas are the XOR with the keyframe
+// coded as alternating zero runs and literal runs, which is small because
+// most of the world does not change between nearby snapshots. Restoring
+// decodes one keyframe and at most one delta. The ring always starts with
+// a keyframe; evicting one drops the deltas that depend on it.
+class RewindBuffer {
+public:
+    int slots = 32, keyframeInterval = 8;
+    // Cost of capture() in ns and bytes held, for reporting.
+    long long lastNs = 0, worstNs = 0, totalNs = 0;
+    long captures = 0;
+
+    void capture(const World& w, long tick);
+    size_t size() const { return count; }
+    long tickAt(size_t back) const { return ring[(head + count - 1 - back) % ring.size()].tick; }
+    size_t bytes() const;
+    // Restores the snapshot back steps before the newest (0 = newest) and
+    // discards everything newer than it; false if there is no such snapshot.
+    bool restore(size_t back, World& w, long& tick);
+    void clear() { count = 0; }
+
+private:
+    struct Slot { long tick; bool keyframe; size_t fullSize; std::vector<uint8_t> data; };
+    Slot& at(size_t i) { return ring[(head + i) % ring.size()]; }
+    std::vector<Slot> ring;
+    size_t head = 0, count = 0;
+    int sinceKeyframe = 0;
+    std::vector<uint8_t> scratch, decoded;
+};
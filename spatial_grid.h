@@ -0,0 +1,84 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include "vec2.h"
+
+// Uniform grid over the arena, rebuilt from scratch every tick. Items are
+// bucketed with a counting sort so each cell's indices are contiguous in
+// `items`. Positions outside the arena are clamped into the border cells,
+// which can only add candidates, never lose them.
+struct SpatialGrid {
+    float cellSize = 20, invCell = 1.0f / 20;
+    int cols = 0, rows = 0;
+    float maxRadius = 0;
+    std::vector<int> cellStart, cellOf, items;
+
+    SpatialGrid(float width, float height, float cell) { init(width, height, cell); }
+
+    void init(float width, float height, float cell) {
+        cellSize = cell;
+        invCell = 1.0f / cell;
+        cols = std::max(1, (int)ceil(width * invCell));
+        rows = std::max(1, (int)ceil(height * invCell));
+        cellStart.assign(cols * rows + 1, 0);
+    }
+
+    void reserve(int maxItems) { cellOf.reserve(maxItems); items.reserve(maxItems); }
+
+    int cellX(float x) const { return std::max(0, std::min(cols - 1, (int)floor(x * invCell))); }
+    int cellY(float y) const { return std::max(0, std::min(rows - 1, (int)floor(y * invCell))); }
+
+    // entry(i, pos, radius) fills in item i and returns false to leave it out.
+    template <typename Entry>
+    void build(int count, Entry entry) {
+        std::fill(cellStart.begin(), cellStart.end(), 0);
+        cellOf.resize(count);
+        maxRadius = 0;
+        for (int i = 0; i < count; i++) {
+            Vec2 p; float r;
+            if (!entry(i, p, r)) { cellOf[i] = -1; continue; }
+            cellOf[i] = cellY(p.y) * cols + cellX(p.x);
+            cellStart[cellOf[i] + 1]++;
+            maxRadius = std::max(maxRadius, r);
+        }
+        for (int c = 0; c < cols * rows; c++) cellStart[c + 1] += cellStart[c];
+        items.resize(cellStart[cols * rows]);
+        // Fill back to front so indices within a cell stay in ascending order.
+        for (int i = count - 1; i >= 0; i--)
+            if (cellOf[i] >= 0) items[--cellStart[cellOf[i] + 1]] = i;
+        // cellStart[c + 1] was walked down to the start of cell c; shift it back.
+        for (int c = 0; c < cols * rows; c++) cellStart[c] = cellStart[c + 1];
+        cellStart[cols * rows] = (int)items.size();
+    }
+
+    // Calls fn(index) for every item in a cell overlapping the square of
+    // half-size r around p.
+    template <typename Fn>
+    void query(Vec2 p, float r, Fn fn) const {
+        int x0 = cellX(p.x - r), x1 = cellX(p.x + r);
+        int y0 = cellY(p.y - r), y1 = cellY(p.y + r);
+        for (int cy = y0; cy <= y1; cy++)
+            for (int cx = x0; cx <= x1; cx++) {
+                int c = cy * cols + cx;
+                for (int k = cellStart[c]; k < cellStart[c + 1]; k++) fn(items[k]);
+            }
+    }
+
+    // Like query(), but visits p's own cell first and stops as soon as fn
+    // returns false, so a capped search sees the closest candidates.
+    template <typename Fn>
+    void queryWhile(Vec2 p, float r, Fn fn) const {
+        int home = cellY(p.y) * cols + cellX(p.x);
+        for (int k = cellStart[home]; k < cellStart[home + 1]; k++)
+            if (!fn(items[k])) return;
+        int x0 = cellX(p.x - r), x1 = cellX(p.x + r);
+        int y0 = cellY(p.y - r), y1 = cellY(p.y + r);
+        for (int cy = y0; cy <= y1; cy++)
+            for (int cx = x0; cx <= x1; cx++) {
+                int c = cy * cols + cx;
+                if (c == home) continue;
+                for (int k = cellStart[c]; k < cellStart[c + 1]; k++)
+                    if (!fn(items[k])) return;
+            }
+    }
+};
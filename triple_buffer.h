@@ -0,0 +1,26 @@
+#pragma once
+#include <atomic>
+
+// Lock-free single-producer/single-consumer triple buffer. The writer fills
+// writeBuffer() and publish()es it; the reader calls update() to pick up the
+// newest published buffer and reads readBuffer() until the next update().
+// Neither side ever waits, and the reader never sees a half-written buffer.
+template <typename T>
+class TripleBuffer {
+public:
+    T& writeBuffer() { return slots[back]; }
+    void publish() { back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX; }
+
+    bool update() {
+        if (!(middle.load(std::memory_order_acquire) & FRESH)) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    const T& readBuffer() const { return slots[front]; }
+
+private:
+    static const int INDEX = 3, FRESH = 4;
+    T slots[3];
+    std::atomic<int> middle{ 1 };
+    int back = 0, front = 2;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <cmath>
+
+struct Vec2 { float x, y; };
+
+inline Vec2 operator+(Vec2 a, Vec2 b) { return { a.x + b.x, a.y + b.y }; }
+inline Vec2 operator-(Vec2 a, Vec2 b) { return { a.x - b.x, a.y - b.y }; }
+inline Vec2 operator*(Vec2 a, float s) { return { a.x * s, a.y * s }; }
+inline float length(Vec2 v) { return sqrt(v.x * v.x + v.y * v.y); }
+inline float dist2(Vec2 a, Vec2 b) { float dx = a.x - b.x, dy = a.y - b.y; return dx * dx + dy * dy; }
+inline Vec2 normalize(Vec2 v) { float l = length(v); return l > 0 ? Vec2{ v.x / l, v.y / l } : v; }
+
+// Swept circle test for two circles that each move in a straight line over
+// a tick, given the offset between their centres at the start (from) and
+// end (to) of it: true if they come within reach of each other, with t the
+// earliest fraction of the tick at which they do.
+inline bool sweptHit(Vec2 from, Vec2 to, float reach, float& t) {
+    Vec2 v = to - from;
+    float a = v.x * v.x + v.y * v.y, end = to.x * to.x + to.y * to.y, r2 = reach * reach;
+    // Further apart at the end than reach plus the whole step: no contact.
+    // (reach + |v|)^2 <= 2 (reach^2 + |v|^2) keeps this free of square roots.
+    if (end > 2 * (r2 + a)) return false;
+    float c = from.x * from.x + from.y * from.y - r2;
+    if (c < 0) { t = 0; return true; }
+    float b = from.x * v.x + from.y * v.y;
+    if (b >= 0 || a <= 0) return false;
+    // Still closing at the end of the tick but not yet within reach.
+    if (-b >= a && end >= r2) return false;
+    float disc = b * b - a * c;
+    if (disc < 0) return false;
+    t = (-b - sqrtf(disc)) / a;
+    return t <= 1;
+}
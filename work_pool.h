@@ -0,0 +1,66 @@
+#pragma once
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool for independent tasks. run() deals the task indices out
+// to one deque per worker; each worker takes from the back of its own deque
+// and, once that is empty, steals from the front of the others'. Long tasks
+// (a game that survives for minutes) therefore do not leave cores idle
+// behind a static split.
+class WorkPool {
+public:
+    explicit WorkPool(int threads) : queues(std::max(1, threads)) {}
+    int threads() const { return (int)queues.size(); }
+
+    // Calls fn(task, worker) for every task in [0, count) and returns when
+    // all are done. fn must be safe to call concurrently for different tasks.
+    template <typename Fn>
+    void run(size_t count, Fn fn) {
+        int n = threads();
+        steals = 0;
+        for (size_t t = 0; t < count; t++) queues[t % n].tasks.push_back(t);
+        std::vector<std::thread> workers;
+        for (int w = 0; w < n; w++)
+            workers.emplace_back([this, w, n, &fn] {
+                size_t task;
+                while (pop(w, task) || steal(w, n, task)) fn(task, w);
+            });
+        for (std::thread& t : workers) t.join();
+    }
+
+    long steals = 0;  // tasks taken from another worker's deque in the last run()
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    bool pop(int w, size_t& task) {
+        std::lock_guard<std::mutex> lock(queues[w].mutex);
+        if (queues[w].tasks.empty()) return false;
+        task = queues[w].tasks.back();
+        queues[w].tasks.pop_back();
+        return true;
+    }
+
+    bool steal(int w, int n, size_t& task) {
+        for (int i = 1; i < n; i++) {
+            Queue& q = queues[(w + i) % n];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) continue;
+            task = q.tasks.front();
+            q.tasks.pop_front();
+            std::lock_guard<std::mutex> count(statsMutex);
+            steals++;
+            return true;
+        }
+        return false;
+    }
+
+    std::vector<Queue> queues;
+    std::mutex statsMutex;
+};